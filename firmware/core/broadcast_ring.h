@@ -0,0 +1,42 @@
+#pragma once
+// Ring of preformatted frames shared by every subscriber of a stream. Each
+// frame is formatted once, straight into its slot, and every subscriber
+// only keeps the sequence number of the next frame it needs, so adding a
+// subscriber costs a cursor, not a copy. A subscriber that falls more than
+// N frames behind skips ahead to the oldest frame still held.
+//
+// Not thread-safe: publish and read from the same task.
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <uint8_t N, size_t SIZE>
+struct BroadcastRing {
+  char frames[N][SIZE];
+  uint16_t lengths[N];
+  uint32_t next; // Sequence number the next frame is published under
+
+  // Slot the next frame is formatted into; publish() makes it readable
+  char* slot() { return frames[next % N]; }
+  void publish(size_t length) {
+    lengths[next % N] = (uint16_t)length;
+    next++;
+  }
+
+  uint32_t oldest() const { return next > N ? next - N : 0; }
+
+  // Moves a lagging cursor up to the oldest held frame; returns the number
+  // of frames it missed
+  uint32_t catchUp(uint32_t& cursor) const {
+    uint32_t first = oldest();
+    if (cursor >= first) return 0;
+    uint32_t missed = first - cursor;
+    cursor = first;
+    return missed;
+  }
+
+  const char* frame(uint32_t seq, size_t& length) const {
+    length = lengths[seq % N];
+    return frames[seq % N];
+  }
+};
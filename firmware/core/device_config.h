@@ -0,0 +1,132 @@
+#pragma once
+// Persisted device settings. The firmware keeps one DeviceConfig in RAM,
+// loads it from NVS once at boot and writes it back as a single blob when
+// something changes, instead of opening a Preferences namespace per setting.
+// The blob carries a layout version and a CRC-32 of everything after the
+// header, so a torn or stale write is detected and never half-applied.
+//
+// Fields are only ever appended, and DEVICE_CONFIG_VERSION is bumped with
+// each addition, with an entry in fieldsEnd(). A blob written by an older
+// version holds its fields followed by the tail padding of its struct, which
+// overlaps the first new fields; load() copies only the old fields and
+// leaves the rest zeroed, i.e. unset.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DEVICE_CONFIG_VERSION 2
+
+// Bits of DeviceConfig::remoteFields: which pulled settings override the
+// firmware defaults
+#define REMOTE_THRESHOLD_RATIO 0x01
+#define REMOTE_WARNING_RATIO 0x02
+#define REMOTE_ALERT_COOLDOWN 0x04
+#define REMOTE_REPORT_DEADBAND 0x08
+#define REMOTE_REPORT_HEARTBEAT 0x10
+// Set over the serial console; a sync of the devices row keeps them
+#define LOCAL_REPORT_DEADBAND 0x20   // reportDeadband outranks the row
+#define LOCAL_NO_SUMMARIES 0x40      // Window summaries turned off
+#define LOCAL_FIELDS (LOCAL_REPORT_DEADBAND | LOCAL_NO_SUMMARIES)
+
+struct DeviceConfig {
+  // Header, filled in by seal()
+  uint16_t version;
+  uint16_t size;
+  uint32_t crc;         // CRC-32 of the bytes after this field
+
+  char deviceId[37];     // Generated once, never changes
+  char registeredId[37]; // deviceId once the devices row exists
+  char userId[64];
+  char ssid[33];
+  char password[65];
+  char email[96];
+  char mobile[24];
+  char staticIp[16];     // Empty for DHCP
+  char gateway[16];
+  char subnet[16];
+  char dns[16];          // Empty to use the gateway
+  uint8_t transport;     // TransportKind
+  char mqttUri[96];
+  char mqttUser[33];
+  char mqttPassword[65];
+  bool lowPower;
+  bool binaryReadings;
+
+  // Version 2: settings pulled from the devices row
+  char location[64];
+  uint8_t remoteFields;      // REMOTE_* and LOCAL_* bits
+  float thresholdRatio;
+  float warningRatio;
+  uint32_t alertCooldown;    // ms
+  float reportDeadband;
+  uint32_t reportHeartbeat;  // ms
+  char remoteUpdatedAt[40];  // updated_at of the applied row, empty if none
+
+  void reset() { memset(this, 0, sizeof(*this)); }
+
+  static size_t headerSize() { return offsetof(DeviceConfig, crc) + sizeof(uint32_t); }
+
+  // Where the fields of each layout version end, indexed by version
+  static size_t fieldsEnd(uint16_t layout) {
+    static const size_t ends[DEVICE_CONFIG_VERSION + 1] = {
+      0,
+      offsetof(DeviceConfig, location), // 1: up to binaryReadings
+      sizeof(DeviceConfig),
+    };
+    return ends[layout];
+  }
+
+  // The blob a version wrote: sizeof() of its struct, i.e. its fields
+  // rounded up to the struct alignment (628 bytes for version 1)
+  static size_t storedSize(uint16_t layout) {
+    size_t align = alignof(DeviceConfig);
+    return (fieldsEnd(layout) + align - 1) / align * align;
+  }
+
+  uint32_t checksum() const {
+    return deviceConfigCrc((const uint8_t*)this + headerSize(), sizeof(*this) - headerSize());
+  }
+
+  void seal() {
+    version = DEVICE_CONFIG_VERSION;
+    size = sizeof(*this);
+    crc = checksum();
+  }
+
+  // Loads a stored blob of this or an older version. Fails, leaving the
+  // config untouched, on a torn write, a bad CRC, a size that isn't its
+  // version's or a newer layout.
+  bool load(const uint8_t* blob, size_t length) {
+    uint16_t blobVersion, blobSize;
+    uint32_t blobCrc;
+    if (length < headerSize() || length > sizeof(*this)) return false;
+    memcpy(&blobVersion, blob + offsetof(DeviceConfig, version), sizeof(blobVersion));
+    memcpy(&blobSize, blob + offsetof(DeviceConfig, size), sizeof(blobSize));
+    memcpy(&blobCrc, blob + offsetof(DeviceConfig, crc), sizeof(blobCrc));
+    if (blobVersion == 0 || blobVersion > DEVICE_CONFIG_VERSION) return false;
+    if (blobSize != length || length != storedSize(blobVersion)) return false;
+    if (deviceConfigCrc(blob + headerSize(), length - headerSize()) != blobCrc) return false;
+    reset();
+    memcpy(this, blob, fieldsEnd(blobVersion)); // Not the padding of an older layout
+    return true;
+  }
+
+  // Bitwise CRC-32 (IEEE, reflected); the config is small and rarely written
+  static uint32_t deviceConfigCrc(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+      crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+  }
+};
+
+// Copies a string into a fixed field, truncating it and zero-filling the
+// rest so equal settings always give equal bytes (and the same CRC)
+template <size_t N>
+void setConfigString(char (&field)[N], const char* value) {
+  strncpy(field, value, N - 1);
+  field[N - 1] = '\0';
+}
@@ -0,0 +1,88 @@
+#pragma once
+// Timing, detection and queue settings of the firmware. esp32_main.cpp and
+// the host tools include this one header, so the simulator runs on the
+// numbers that ship instead of a copy of them.
+
+#include <stdint.h>
+
+#include "gas_detector.h"
+#include "reading_reporter.h"
+
+// ==================== TASK PERIODS ====================
+// Sensing scheduler
+#define ADC_FRAME_PERIOD 10    // pollAdcFrames(): 100 frames/s
+#define SAMPLE_PERIOD 50       // sampleTask(): filtered value -> baseline -> detector
+// Network scheduler
+#define EVENT_DRAIN_PERIOD 100 // drainSensorEvents()
+#define UPLOAD_PERIOD 500      // uploadTask()
+
+// ==================== GAS DETECTION ====================
+const unsigned long ALERT_COOLDOWN = 60000; // Per alert type; escalations are never held back
+const float GAS_THRESHOLD_RATIO = 1.5;      // Emergency at 1.5x the clean-air baseline...
+const float GAS_WARNING_RATIO = 1.2;        // ...warning at 1.2x
+const float GAS_EMA_ALPHA = 0.2;            // ~50ms time constant at 100 frames/s
+
+// Alarm hysteresis: levels must hold for a dwell time before the state
+// changes, and the all-clear needs the value 5% below the warning level.
+// The alarm still sounds within a quarter second of a real leak.
+const float GAS_HYSTERESIS = 0.05;
+const unsigned long EMERGENCY_DWELL = 250;
+const unsigned long WARNING_DWELL = 1000;
+const unsigned long CLEAR_DWELL = 5000;
+
+inline GasDetectorConfig defaultDetectorConfig() {
+  GasDetectorConfig config;
+  config.thresholdRatio = GAS_THRESHOLD_RATIO;
+  config.warningRatio = GAS_WARNING_RATIO;
+  config.alertCooldown = ALERT_COOLDOWN;
+  config.hysteresis = GAS_HYSTERESIS;
+  config.emergencyDwell = EMERGENCY_DWELL;
+  config.warningDwell = WARNING_DWELL;
+  config.clearDwell = CLEAR_DWELL;
+  return config;
+}
+
+// ==================== BASELINE TRACKING ====================
+// Blocks are 1s of samples; rises follow a 6h time constant, falls a 2min one
+#define BASELINE_BLOCK_SAMPLES 20                      // 20 samples at 50ms
+#define BASELINE_WARMUP_BLOCKS 5                       // 5s, as the old calibration
+const float BASELINE_ALPHA_UP = 1.0 / (6 * 3600);
+const float BASELINE_ALPHA_DOWN = 1.0 / 120;
+const float BASELINE_FREEZE_RATIO = 1.1;               // Below the 1.2x warning level
+
+// ==================== ALERT QUEUES ====================
+#define URGENT_ALERT_CAPACITY 4
+#define PENDING_ALERT_CAPACITY 8
+#define ALERT_TYPE_SIZE 24
+#define ALERT_MESSAGE_SIZE 128
+#define ALERT_SENSOR_DATA_SIZE 192
+const unsigned long URGENT_RETRY_MIN = 250;  // First retry delay for a failed emergency
+const unsigned long URGENT_RETRY_MAX = 8000; // Retry delay cap
+const uint32_t ALERT_LATENCY_BOUNDS[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000 };
+#define SENSOR_EVENT_QUEUE_SIZE 64
+
+// ==================== READING BUFFER ====================
+#define READING_BUFFER_CAPACITY 60
+const unsigned long READING_INTERVAL = 5000;       // Consider a reading every 5 seconds
+const float READING_DEADBAND = 5.0;                // ...and queue it once the window mean moved this far
+const float READING_EXCURSION = 12.0;              // ...or a peak/dip within the window moved this far
+const unsigned long READING_HEARTBEAT = 300000;    // ...or nothing was queued for 5 minutes
+const uint16_t READING_BATCH_SIZE = 12;            // Flush once this many readings are queued
+const unsigned long READING_BATCH_MAX_AGE = 60000; // ...or once the oldest queued reading is 60s old
+const unsigned long READING_FLUSH_RETRY = 15000;   // Wait before retrying a failed flush
+const uint16_t READING_UPLOAD_MAX = 30;            // Most readings sent in one request
+#define UPLOAD_BUFFER_SIZE 10240                   // Fits READING_UPLOAD_MAX rows
+
+inline ReadingReporterConfig defaultReporterConfig() {
+  ReadingReporterConfig config;
+  config.deadband = READING_DEADBAND;
+  config.excursion = READING_EXCURSION;
+  config.heartbeat = READING_HEARTBEAT;
+  config.summaries = true;
+  return config;
+}
+
+// ==================== BACKEND ====================
+const unsigned long SUPABASE_BACKOFF_MIN = 1000;  // First retry delay after a failed request
+const unsigned long SUPABASE_BACKOFF_MAX = 60000; // Retry delay cap
+const unsigned long BOOT_RETRY_DELAY = 30000;     // After a failed registration or announcement
@@ -0,0 +1,65 @@
+#pragma once
+// Clean-air baseline of the MQ5, tracked continuously instead of measured
+// once at boot. Filtered samples are averaged in blocks; each block mean
+// moves the baseline by an EMA. Rises are followed slowly (temperature,
+// humidity, ageing) and ignored entirely while a block sits above
+// freezeRatio x baseline or the caller holds it (alarm active), so a leak is
+// never learned as clean air. Falls are followed quickly, which only ever
+// makes the detector more sensitive, e.g. while a cold sensor settles.
+// Until warmupBlocks blocks have been seen the baseline is their plain mean,
+// which is what the old one-shot calibration computed.
+
+#include <stdint.h>
+
+struct GasBaseline {
+  uint16_t blockSize;    // Samples per block
+  uint16_t warmupBlocks; // Blocks averaged before tracking starts
+  float alphaUp;         // EMA weight per block for rising blocks
+  float alphaDown;       // EMA weight per block for falling blocks
+  float freezeRatio;     // Blocks above baseline * freezeRatio are rejected
+  float value;
+  uint32_t blocks;       // Blocks accepted since the last reset
+  uint32_t frozenBlocks; // Blocks rejected as a possible leak
+  float blockSum;
+  uint16_t blockCount;
+
+  bool ready() const { return blocks >= warmupBlocks; }
+
+  // O(1) per sample. Returns true when a block completed and moved the baseline.
+  bool update(float sample, bool hold) {
+    blockSum += sample;
+    if (++blockCount < blockSize) return false;
+    float mean = blockSum / blockCount;
+    blockSum = 0;
+    blockCount = 0;
+
+    if (!ready()) {
+      value += (mean - value) / (blocks + 1);
+    } else if (mean > value) {
+      if (hold || mean > value * freezeRatio) {
+        frozenBlocks++;
+        return false;
+      }
+      value += alphaUp * (mean - value);
+    } else {
+      value += alphaDown * (mean - value);
+    }
+    blocks++;
+    return true;
+  }
+
+  // Continues from a persisted baseline without warming up again
+  void restore(float stored) {
+    value = stored;
+    blocks = warmupBlocks;
+    blockSum = 0;
+    blockCount = 0;
+  }
+
+  void reset() {
+    value = 0;
+    blocks = 0;
+    blockSum = 0;
+    blockCount = 0;
+  }
+};
@@ -0,0 +1,176 @@
+#pragma once
+// Gas level state machine. update() is evaluated once per filtered sample
+// and reports the transition it made; whether that transition should be
+// reported to the backend is decided by a per-type alert cooldown.
+//
+// Transitions are table-driven. Each rule fires when the value stays above
+// an entry level, or below that level's exit band, for the rule's dwell
+// time. The exit band sits `hysteresis` below the entry level, so noise
+// around a level can't toggle the state. A condition that starts but
+// doesn't last its dwell time is counted in `suppressed`. The levels, dwell
+// times and cooldown come from a GasDetectorConfig.
+//
+// The cooldown only holds back repeats of the same transition type.
+// Escalations past the last reported state are always reported, and a
+// held-back transition is reported by reportDue() once its cooldown ends,
+// so the backend never stays on a stale state.
+
+#include <stdint.h>
+
+enum GasTransition : uint8_t {
+  TRANSITION_NONE,
+  TRANSITION_EMERGENCY, // Rose above the threshold
+  TRANSITION_WARNING,   // Rose above the warning level
+  TRANSITION_NORMAL     // Fell back below the warning level's exit band
+};
+
+enum GasState : uint8_t {
+  STATE_NORMAL,
+  STATE_WARNING,
+  STATE_EMERGENCY
+};
+
+enum GasLevelRef : uint8_t { LEVEL_THRESHOLD, LEVEL_WARNING };
+enum GasDwellRef : uint8_t { DWELL_EMERGENCY, DWELL_WARNING, DWELL_CLEAR };
+
+struct GasRule {
+  GasState from;
+  GasLevelRef level;
+  bool rising;          // Above the level, or below its exit band
+  GasDwellRef dwell;
+  GasState to;
+  GasTransition transition;
+};
+
+// First matching rule of the current state wins, so escalations come first
+static const GasRule GAS_RULES[] = {
+  { STATE_NORMAL,    LEVEL_THRESHOLD, true,  DWELL_EMERGENCY, STATE_EMERGENCY, TRANSITION_EMERGENCY },
+  { STATE_NORMAL,    LEVEL_WARNING,   true,  DWELL_WARNING,   STATE_WARNING,   TRANSITION_WARNING },
+  { STATE_WARNING,   LEVEL_THRESHOLD, true,  DWELL_EMERGENCY, STATE_EMERGENCY, TRANSITION_EMERGENCY },
+  { STATE_WARNING,   LEVEL_WARNING,   false, DWELL_CLEAR,     STATE_NORMAL,    TRANSITION_NORMAL },
+  { STATE_EMERGENCY, LEVEL_WARNING,   false, DWELL_CLEAR,     STATE_NORMAL,    TRANSITION_NORMAL },
+};
+#define GAS_RULE_COUNT (sizeof(GAS_RULES) / sizeof(GAS_RULES[0]))
+
+// Tunable settings of a detector, set by name so adding a field can't shift
+// the others. Everything else in GasDetector is runtime state.
+struct GasDetectorConfig {
+  float thresholdRatio;    // threshold as a multiple of the clean-air baseline
+  float warningRatio;      // warningLevel as a multiple of the clean-air baseline
+  uint32_t alertCooldown;  // Minimum time between reports of the same transition (ms)
+  float hysteresis;        // Exit band, as a fraction below the entry level
+  uint32_t emergencyDwell; // ms above the threshold before the alarm
+  uint32_t warningDwell;   // ms above the warning level before the warning
+  uint32_t clearDwell;     // ms below the exit band before the all-clear
+};
+
+struct GasDetector {
+  GasDetectorConfig config;
+  float threshold;
+  float warningLevel;
+  GasState state;
+  GasState reportedState;  // Target state of the last reported transition
+  uint32_t lastNotified[4]; // Per transition type, when it was last reported
+  uint8_t notifiedTypes;   // Bit per transition type reported since boot
+  bool notify;             // Set by update() when the transition should be reported
+  int8_t pendingRule;      // Rule whose condition currently holds, -1 if none
+  uint32_t pendingSince;
+  uint32_t suppressed;     // Conditions that ended before their dwell time
+  uint32_t held;           // Transitions held back by the cooldown
+
+  // Starts in STATE_NORMAL with nothing reported; the levels apply until
+  // the first calibrate()
+  GasDetector(const GasDetectorConfig& settings, float initialThreshold, float initialWarningLevel)
+    : config(settings), threshold(initialThreshold), warningLevel(initialWarningLevel), state(STATE_NORMAL),
+      reportedState(STATE_NORMAL), lastNotified(), notifiedTypes(0), notify(false), pendingRule(-1),
+      pendingSince(0), suppressed(0), held(0) {}
+
+  bool alertActive() const { return state == STATE_EMERGENCY; }
+  bool warningActive() const { return state == STATE_WARNING; }
+
+  GasTransition update(float value, uint32_t now) {
+    notify = false;
+
+    int8_t match = -1;
+    for (uint8_t i = 0; i < GAS_RULE_COUNT; i++) {
+      const GasRule& rule = GAS_RULES[i];
+      if (rule.from != state) continue;
+      float level = rule.level == LEVEL_THRESHOLD ? threshold : warningLevel;
+      if (rule.rising ? value > level : value < level * (1 - config.hysteresis)) {
+        match = i;
+        break;
+      }
+    }
+
+    if (match < 0) {
+      if (pendingRule >= 0) suppressed++;
+      pendingRule = -1;
+      return TRANSITION_NONE;
+    }
+    if (match != pendingRule) {
+      pendingRule = match;
+      pendingSince = now;
+    }
+
+    const GasRule& rule = GAS_RULES[match];
+    if (now - pendingSince < dwellTime(rule.dwell)) return TRANSITION_NONE;
+
+    state = rule.to;
+    pendingRule = -1;
+    if (mayReport(rule.transition, now)) {
+      markReported(rule.transition, now);
+    } else {
+      held++;
+    }
+    return rule.transition;
+  }
+
+  // The transition into the current state if its report was held back and
+  // the cooldown has since run out, TRANSITION_NONE otherwise
+  GasTransition reportDue(uint32_t now) {
+    if (state == reportedState) return TRANSITION_NONE;
+    GasTransition transition = transitionTo(state);
+    if (!mayReport(transition, now)) return TRANSITION_NONE;
+    markReported(transition, now);
+    return transition;
+  }
+
+  bool mayReport(GasTransition transition, uint32_t now) const {
+    if (state > reportedState) return true; // Escalation
+    if (!(notifiedTypes & (1 << transition))) return true;
+    return now - lastNotified[transition] > config.alertCooldown;
+  }
+
+  void markReported(GasTransition transition, uint32_t now) {
+    notify = true;
+    reportedState = state;
+    lastNotified[transition] = now;
+    notifiedTypes |= 1 << transition;
+  }
+
+  static GasTransition transitionTo(GasState to) {
+    if (to == STATE_EMERGENCY) return TRANSITION_EMERGENCY;
+    if (to == STATE_WARNING) return TRANSITION_WARNING;
+    return TRANSITION_NORMAL;
+  }
+
+  uint32_t dwellTime(GasDwellRef dwell) const {
+    if (dwell == DWELL_EMERGENCY) return config.emergencyDwell;
+    if (dwell == DWELL_WARNING) return config.warningDwell;
+    return config.clearDwell;
+  }
+
+  // Derives both levels from the clean-air baseline
+  void calibrate(float cleanAir) {
+    threshold = cleanAir * config.thresholdRatio;
+    warningLevel = cleanAir * config.warningRatio;
+  }
+
+  const char* statusString() const { return stateName(state); }
+
+  static const char* stateName(GasState value) {
+    if (value == STATE_EMERGENCY) return "EMERGENCY";
+    if (value == STATE_WARNING) return "WARNING";
+    return "NORMAL";
+  }
+};
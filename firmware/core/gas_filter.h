@@ -0,0 +1,61 @@
+#pragma once
+// Noise filter for decimated MQ5 ADC frames: a 3-tap median rejects
+// single-frame glitches, an EMA smooths the rest. The filtered value is
+// also folded into min/max/mean statistics for the current reporting window.
+
+#include <stdint.h>
+
+struct GasWindow {
+  float min;
+  float max;
+  float sum;
+  uint32_t count;
+
+  void add(float value) {
+    if (count == 0 || value < min) min = value;
+    if (count == 0 || value > max) max = value;
+    sum += value;
+    count++;
+  }
+
+  float mean() const { return count > 0 ? sum / count : 0; }
+
+  void reset() {
+    sum = 0;
+    count = 0;
+  }
+};
+
+struct GasFilter {
+  float alpha;     // EMA weight of the newest frame
+  float taps[3];
+  uint8_t fill;
+  uint32_t frames; // Frames seen since boot
+  float value;     // Current filtered value
+  GasWindow window;
+
+  float update(float raw) {
+    taps[frames % 3] = raw;
+    frames++;
+    if (fill < 3) fill++;
+
+    float median = raw;
+    if (fill == 3) {
+      float a = taps[0], b = taps[1], c = taps[2];
+      float lo = a < b ? a : b;
+      float hi = a < b ? b : a;
+      median = c < lo ? lo : (c > hi ? hi : c);
+    }
+
+    value = fill == 1 ? median : value + alpha * (median - value);
+    window.add(value);
+    return value;
+  }
+
+  // Forgets the filter history, e.g. after the sensor wasn't sampled for a
+  // while; the next frame is taken as is
+  void restart() {
+    fill = 0;
+    window.reset();
+  }
+};
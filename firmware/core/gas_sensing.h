@@ -0,0 +1,128 @@
+#pragma once
+// Sensing side of the firmware, run by sampleTask() every SAMPLE_PERIOD:
+// the filtered ADC value becomes the gas level, feeds the baseline and the
+// detector, and readings and alerts are handed to the network side through
+// a lock-free queue. The caller drives the alarm from the transition that
+// check() returns; nothing here touches the hardware or the clock.
+
+#include <stdint.h>
+
+#include "firmware_constants.h"
+#include "gas_baseline.h"
+#include "gas_detector.h"
+#include "gas_filter.h"
+#include "reading_reporter.h"
+#include "spsc_queue.h"
+
+enum SensorEventType : uint8_t {
+  EVENT_READING,
+  EVENT_ALERT
+};
+
+struct SensorEvent {
+  SensorEventType type;
+  GasTransition transition; // EVENT_ALERT only
+  uint32_t timestamp;       // millis() on the sensing core
+  float gasValue;
+  float gasPercentage;
+  float threshold;          // Threshold or warning level that was crossed
+  float gasMin;             // Reading window statistics (EVENT_READING only)
+  float gasMax;
+  float gasMean;
+};
+
+// The sensing task is the only producer and the network task the only
+// consumer, so a slow request can never stall sampling or the buzzer
+typedef SpscQueue<SensorEvent, SENSOR_EVENT_QUEUE_SIZE> SensorEventQueue;
+
+struct GasSensing {
+  GasFilter& filter;
+  GasBaseline& baseline;
+  GasDetector& detector;
+  ReadingReporter& reporter;
+  float gasValue;
+  float gasPercentage;
+  uint32_t lastReadingTime;
+  volatile bool calibrationRequested; // Restart the warm-up on the sensing task
+  SensorEventQueue events;
+  uint32_t eventsDropped;             // Written by the sensing task only
+
+  GasSensing(GasFilter& gasFilter, GasBaseline& gasBaseline, GasDetector& gasDetector, ReadingReporter& readingReporter)
+    : filter(gasFilter), baseline(gasBaseline), detector(gasDetector), reporter(readingReporter),
+      gasValue(0), gasPercentage(0), lastReadingTime(0), calibrationRequested(false), eventsDropped(0) {}
+
+  // Takes the current filter output; the percentage is of a 2500-count scale
+  void read() {
+    gasValue = filter.value;
+    gasPercentage = (gasValue / 2500.0f) * 100.0f;
+    if (gasPercentage > 100) gasPercentage = 100;
+    if (gasPercentage < 0) gasPercentage = 0;
+  }
+
+  // Feeds the baseline and derives the thresholds from it. Returns true
+  // once, when the baseline has just become ready.
+  bool updateBaseline() {
+    if (calibrationRequested) {
+      calibrationRequested = false;
+      baseline.reset();
+    }
+
+    bool wasReady = baseline.ready();
+    if (!baseline.update(gasValue, detector.alertActive() || detector.warningActive()) || !baseline.ready()) return false;
+    detector.calibrate(baseline.value);
+    return !wasReady;
+  }
+
+  // Queues a reading when the reporter wants one, runs the detector and
+  // posts the alerts it reports. Returns the transition the detector made.
+  GasTransition check(uint32_t now) {
+    if (now - lastReadingTime > READING_INTERVAL) {
+      if (reporter.due(gasValue, filter.window, now)) {
+        post(EVENT_READING, TRANSITION_NONE, 0, now); // Temperature, humidity, pressure are not sensed yet
+      }
+      lastReadingTime = now;
+    }
+
+    GasTransition transition = detector.update(gasValue, now);
+    if (transition != TRANSITION_NONE && detector.notify) {
+      post(EVENT_ALERT, transition, levelCrossed(transition), now);
+    }
+
+    // A transition the cooldown held back is reported once it may be
+    GasTransition due = detector.reportDue(now);
+    if (due != TRANSITION_NONE) {
+      post(EVENT_ALERT, due, levelCrossed(due), now);
+    }
+    return transition;
+  }
+
+  float levelCrossed(GasTransition transition) const {
+    return transition == TRANSITION_EMERGENCY ? detector.threshold : detector.warningLevel;
+  }
+
+  // Hands a reading or alert to the network task; never blocks. A reading
+  // carries the window statistics since the previous one.
+  void post(SensorEventType type, GasTransition transition, float threshold, uint32_t now) {
+    SensorEvent event;
+    event.type = type;
+    event.transition = transition;
+    event.timestamp = now;
+    event.gasValue = gasValue;
+    event.gasPercentage = gasPercentage;
+    event.threshold = threshold;
+    event.gasMin = gasValue;
+    event.gasMax = gasValue;
+    event.gasMean = gasValue;
+    if (type == EVENT_READING) {
+      if (filter.window.count > 0) {
+        event.gasMin = filter.window.min;
+        event.gasMax = filter.window.max;
+        event.gasMean = filter.window.mean();
+      }
+      filter.window.reset();
+    }
+    if (!events.push(event)) {
+      eventsDropped++;
+    }
+  }
+};
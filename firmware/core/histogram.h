@@ -0,0 +1,47 @@
+#pragma once
+// Fixed-bucket histogram for latencies and durations. Bucket bounds are
+// inclusive upper limits in a caller-owned table, in ascending order; one
+// extra bucket counts everything above the last bound. add() is a short
+// linear scan and never allocates, so it can sit on hot paths.
+
+#include <stdint.h>
+
+#include "json_writer.h"
+
+template <uint8_t N>
+struct Histogram {
+  const uint32_t* bounds; // N upper bounds
+  uint32_t counts[N + 1];
+  uint32_t count;
+  uint64_t sum;
+  uint32_t max;
+
+  void add(uint32_t value) {
+    uint8_t i = 0;
+    while (i < N && value > bounds[i]) i++;
+    counts[i]++;
+    count++;
+    sum += value;
+    if (value > max) max = value;
+  }
+
+  uint32_t mean() const { return count > 0 ? (uint32_t)(sum / count) : 0; }
+
+  // {"le":[...],"counts":[...],"count":n,"mean":m,"max":m}; the last count
+  // is the overflow bucket, so counts has one entry more than le
+  void writeJson(JsonWriter& json) const {
+    json.beginObject();
+    json.key("le");
+    json.beginArray();
+    for (uint8_t i = 0; i < N; i++) json.value((unsigned long)bounds[i]);
+    json.endArray();
+    json.key("counts");
+    json.beginArray();
+    for (uint8_t i = 0; i <= N; i++) json.value((unsigned long)counts[i]);
+    json.endArray();
+    json.field("count", (unsigned long)count);
+    json.field("mean", (unsigned long)mean());
+    json.field("max", (unsigned long)max);
+    json.endObject();
+  }
+};
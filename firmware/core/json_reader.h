@@ -0,0 +1,169 @@
+#pragma once
+// Single-pass, allocation-free extraction of top-level keys from a JSON
+// object (or from the first object of an array, as PostgREST returns).
+// Strings are unescaped into the field buffer; numbers and booleans are
+// copied as their literal text. A null value counts as absent, so the field
+// stays empty and not found. Nested values that aren't requested are
+// skipped without being copied.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_MAX_BODY 1024 // Largest request body accepted by the web API
+
+struct JsonField {
+  const char* key;
+  char* out;
+  size_t size;
+  bool found; // Set when the key was present and its value fit into out
+};
+
+struct JsonReader {
+  const char* p;
+  const char* end;
+
+  void skipWhitespace() {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+  }
+
+  bool consume(char c) {
+    skipWhitespace();
+    if (p >= end || *p != c) return false;
+    p++;
+    return true;
+  }
+
+  static void putUtf8(uint32_t cp, char* out, size_t size, size_t& n, bool& fits) {
+    char bytes[4];
+    size_t len;
+    if (cp < 0x80) { bytes[0] = cp; len = 1; }
+    else if (cp < 0x800) { bytes[0] = 0xC0 | (cp >> 6); bytes[1] = 0x80 | (cp & 0x3F); len = 2; }
+    else { bytes[0] = 0xE0 | (cp >> 12); bytes[1] = 0x80 | ((cp >> 6) & 0x3F); bytes[2] = 0x80 | (cp & 0x3F); len = 3; }
+    for (size_t i = 0; i < len; i++) {
+      if (out != nullptr && n + 1 < size) out[n++] = bytes[i];
+      else fits = false;
+    }
+  }
+
+  // Reads a string token; out may be null to skip it. Returns false on
+  // malformed input, sets fits=false if out was too small.
+  bool readString(char* out, size_t size, bool& fits) {
+    fits = true;
+    size_t n = 0;
+    if (!consume('"')) return false;
+    while (p < end && *p != '"') {
+      char c = *p++;
+      if (c == '\\') {
+        if (p >= end) return false;
+        char e = *p++;
+        switch (e) {
+          case 'n': c = '\n'; break;
+          case 't': c = '\t'; break;
+          case 'r': c = '\r'; break;
+          case 'b': c = '\b'; break;
+          case 'f': c = '\f'; break;
+          case 'u': {
+            if (end - p < 4) return false;
+            char hex[5] = { p[0], p[1], p[2], p[3], '\0' };
+            p += 4;
+            putUtf8(strtoul(hex, nullptr, 16), out, size, n, fits);
+            continue;
+          }
+          default: c = e; break; // \" \\ \/
+        }
+      }
+      if (out != nullptr && n + 1 < size) out[n++] = c;
+      else fits = false;
+    }
+    if (out != nullptr && size > 0) out[n] = '\0';
+    return consume('"');
+  }
+
+  // Copies a number/true/false/null literal as text
+  bool readLiteral(char* out, size_t size, bool& fits) {
+    fits = true;
+    skipWhitespace();
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') p++;
+    size_t len = p - start;
+    if (len == 0) return false;
+    if (out != nullptr) {
+      fits = len < size;
+      if (!fits) len = size - 1;
+      memcpy(out, start, len);
+      out[len] = '\0';
+    }
+    return true;
+  }
+
+  bool atNull() const { return end - p >= 4 && strncmp(p, "null", 4) == 0; }
+
+  // Skips any value, including nested objects and arrays
+  bool skipValue() {
+    skipWhitespace();
+    if (p >= end) return false;
+    bool fits;
+    if (*p == '"') return readString(nullptr, 0, fits);
+    if (*p != '{' && *p != '[') return readLiteral(nullptr, 0, fits);
+
+    int depth = 0;
+    while (p < end) {
+      char c = *p;
+      if (c == '"') {
+        if (!readString(nullptr, 0, fits)) return false;
+        continue;
+      }
+      p++;
+      if (c == '{' || c == '[') depth++;
+      else if (c == '}' || c == ']') {
+        if (--depth == 0) return true;
+      }
+    }
+    return false;
+  }
+};
+
+// Scans the document once and fills every requested field it finds.
+// Returns false if the JSON is malformed or larger than maxLength.
+inline bool parseJsonFields(const char* json, size_t length, JsonField* fields, uint8_t count, size_t maxLength = JSON_MAX_BODY) {
+  for (uint8_t i = 0; i < count; i++) {
+    fields[i].found = false;
+    if (fields[i].size > 0) fields[i].out[0] = '\0';
+  }
+  if (json == nullptr || length > maxLength) return false;
+
+  JsonReader reader = { json, json + length };
+  reader.skipWhitespace();
+  if (reader.consume('[')) {
+    if (reader.consume(']')) return true; // Empty result set
+  }
+  if (!reader.consume('{')) return false;
+  if (reader.consume('}')) return true;
+
+  char key[32];
+  do {
+    bool keyFits;
+    if (!reader.readString(key, sizeof(key), keyFits) || !reader.consume(':')) return false;
+
+    JsonField* match = nullptr;
+    for (uint8_t i = 0; keyFits && i < count; i++) {
+      if (strcmp(key, fields[i].key) == 0) match = &fields[i];
+    }
+
+    reader.skipWhitespace();
+    bool ok, fits = false;
+    if (match == nullptr || reader.p >= reader.end || *reader.p == '{' || *reader.p == '[' || reader.atNull()) {
+      ok = reader.skipValue();
+    } else if (*reader.p == '"') {
+      ok = reader.readString(match->out, match->size, fits);
+    } else {
+      ok = reader.readLiteral(match->out, match->size, fits);
+    }
+    if (!ok) return false;
+    if (match != nullptr) match->found = fits;
+  } while (reader.consume(','));
+
+  return reader.consume('}');
+}
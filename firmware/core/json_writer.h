@@ -0,0 +1,114 @@
+#pragma once
+// Streaming JSON writer into a caller-supplied buffer. It never allocates;
+// when the buffer is too small the output is truncated and ok() is false.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+struct JsonWriter {
+  char* buf;
+  size_t capacity;
+  size_t length;
+  bool overflow;
+  bool afterKey;
+  uint8_t depth;
+  uint32_t hasItems; // Bit n set: the container at depth n has an element
+
+  JsonWriter(char* buffer, size_t size)
+    : buf(buffer), capacity(size), length(0), overflow(false), afterKey(false), depth(0), hasItems(0) {
+    if (capacity > 0) buf[0] = '\0';
+  }
+
+  void put(const char* text, size_t n) {
+    if (length + n >= capacity) {
+      n = capacity > length + 1 ? capacity - length - 1 : 0;
+      overflow = true;
+    }
+    memcpy(buf + length, text, n);
+    length += n;
+    if (capacity > 0) buf[length] = '\0';
+  }
+  void put(const char* text) { put(text, strlen(text)); }
+  void put(char c) { put(&c, 1); }
+
+  // Appends snprintf output of at most size - 1 characters; n is what
+  // snprintf returned, which may exceed that when it truncated
+  void putFormatted(const char* text, size_t size, int n) {
+    if (n < 0 || (size_t)n >= size) {
+      overflow = true;
+      n = n < 0 ? 0 : (int)size - 1;
+    }
+    put(text, n);
+  }
+
+  // Emits the comma between elements, except right after a key
+  void separator() {
+    if (afterKey) {
+      afterKey = false;
+      return;
+    }
+    if (hasItems & (1UL << depth)) put(',');
+    hasItems |= 1UL << depth;
+  }
+
+  void putEscaped(const char* text) {
+    put('"');
+    for (const char* c = text; *c != '\0'; c++) {
+      unsigned char ch = *c;
+      switch (ch) {
+        case '"':  put("\\\"", 2); break;
+        case '\\': put("\\\\", 2); break;
+        case '\n': put("\\n", 2); break;
+        case '\r': put("\\r", 2); break;
+        case '\t': put("\\t", 2); break;
+        default:
+          if (ch < 0x20) {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+            put(escaped, 6);
+          } else {
+            put((char)ch);
+          }
+      }
+    }
+    put('"');
+  }
+
+  void beginObject() { separator(); put('{'); depth++; hasItems &= ~(1UL << depth); }
+  void endObject() { depth--; put('}'); }
+  void beginArray() { separator(); put('['); depth++; hasItems &= ~(1UL << depth); }
+  void endArray() { depth--; put(']'); }
+
+  void key(const char* name) { separator(); putEscaped(name); put(':'); afterKey = true; }
+
+  void value(const char* text) { separator(); if (text == nullptr) put("null", 4); else putEscaped(text); }
+  void value(bool flag) { separator(); if (flag) put("true", 4); else put("false", 5); }
+  void value(int number) { value((long)number); }
+  void value(unsigned int number) { value((unsigned long)number); }
+  // 21 bytes hold any 64-bit value with its sign
+  void value(long number) { char tmp[21]; separator(); putFormatted(tmp, sizeof(tmp), snprintf(tmp, sizeof(tmp), "%ld", number)); }
+  void value(unsigned long number) { char tmp[21]; separator(); putFormatted(tmp, sizeof(tmp), snprintf(tmp, sizeof(tmp), "%lu", number)); }
+  void value(double number, uint8_t decimals = 2) {
+    separator();
+    if (isnan(number) || isinf(number)) {
+      put("null", 4);
+      return;
+    }
+    char tmp[32]; // Larger magnitudes don't fit and mark the output as overflowed
+    putFormatted(tmp, sizeof(tmp), snprintf(tmp, sizeof(tmp), "%.*f", decimals, number));
+  }
+  // Inserts an already serialized JSON value (e.g. sensor_data) verbatim
+  void raw(const char* json) { separator(); put(json); }
+
+  template <typename T>
+  void field(const char* name, T v) { key(name); value(v); }
+  void field(const char* name, double v, uint8_t decimals) { key(name); value(v, decimals); }
+  void rawField(const char* name, const char* json) { key(name); raw(json); }
+
+  bool ok() const { return !overflow; }
+  const char* c_str() const { return buf; }
+  size_t size() const { return length; }
+};
@@ -0,0 +1,121 @@
+#pragma once
+// Runtime metrics output. PromWriter renders counters, gauges and
+// Histogram<N>s in the Prometheus text format. Output goes line by line
+// into a small buffer that is handed to a flush callback whenever the
+// next line might not fit, so a large exposition can be streamed.
+//
+// MetricsSummary is the handful of numbers piggybacked on reading uploads.
+// Its fields are sent by position in binary batches, so only append to it,
+// and keep METRICS_SUMMARY_NAMES in sync with
+// supabase/functions/_shared/reading_codec.ts.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "histogram.h"
+#include "json_writer.h"
+
+typedef void (*MetricsFlush)(const char* text, size_t length, void* context);
+
+struct PromWriter {
+  char* buf;
+  size_t capacity;
+  size_t length;
+  MetricsFlush flush;
+  void* context;
+
+  PromWriter(char* buffer, size_t size, MetricsFlush sink, void* sinkContext)
+    : buf(buffer), capacity(size), length(0), flush(sink), context(sinkContext) {}
+
+  // Appends one line; a line longer than the whole buffer is cut short
+  void line(const char* format, ...) {
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+      va_list args;
+      va_start(args, format);
+      int n = vsnprintf(buf + length, capacity - length, format, args);
+      va_end(args);
+      if (n >= 0 && length + n + 1 < capacity) {
+        length += n;
+        buf[length++] = '\n';
+        return;
+      }
+      finish();
+    }
+    length = capacity - 1;
+    buf[length - 1] = '\n';
+  }
+
+  void finish() {
+    if (length > 0) flush(buf, length, context);
+    length = 0;
+  }
+
+  void family(const char* name, const char* type, const char* help) {
+    line("# HELP %s %s", name, help);
+    line("# TYPE %s %s", name, type);
+  }
+
+  void counter(const char* name, const char* help, unsigned long value) {
+    family(name, "counter", help);
+    line("%s %lu", name, value);
+  }
+
+  void gauge(const char* name, const char* help, unsigned long value) {
+    family(name, "gauge", help);
+    line("%s %lu", name, value);
+  }
+
+  // One labelled series of a histogram family; labels is e.g. `code="2xx"`
+  // or empty. Bucket counts are cumulative, as Prometheus expects.
+  template <uint8_t N>
+  void histogram(const char* name, const char* labels, const Histogram<N>& histogram) {
+    const char* sep = labels[0] != '\0' ? "," : "";
+    unsigned long cumulative = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      cumulative += histogram.counts[i];
+      line("%s_bucket{%s%sle=\"%lu\"} %lu", name, labels, sep, (unsigned long)histogram.bounds[i], cumulative);
+    }
+    line("%s_bucket{%s%sle=\"+Inf\"} %lu", name, labels, sep, (unsigned long)histogram.count);
+    if (labels[0] != '\0') {
+      line("%s_sum{%s} %llu", name, labels, (unsigned long long)histogram.sum);
+      line("%s_count{%s} %lu", name, labels, (unsigned long)histogram.count);
+    } else {
+      line("%s_sum %llu", name, (unsigned long long)histogram.sum);
+      line("%s_count %lu", name, (unsigned long)histogram.count);
+    }
+  }
+};
+
+enum MetricsSummaryField : uint8_t {
+  SUMMARY_UPTIME_S,
+  SUMMARY_FREE_HEAP,
+  SUMMARY_LARGEST_BLOCK,
+  SUMMARY_MIN_FREE_HEAP,
+  SUMMARY_LOOP_MAX_US,      // Slowest scheduler pass of either core
+  SUMMARY_REQUESTS,
+  SUMMARY_REQUEST_FAILURES, // No response, or HTTP 4xx/5xx
+  SUMMARY_REQUEST_AVG_MS,
+  SUMMARY_TLS_AVG_MS,
+  SUMMARY_WIFI_RECONNECTS,
+  SUMMARY_HELD_ALERTS,      // Held back by the alert cooldown
+  SUMMARY_FIELD_COUNT
+};
+
+static const char* const METRICS_SUMMARY_NAMES[SUMMARY_FIELD_COUNT] = {
+  "uptime_s", "free_heap", "largest_block", "min_free_heap", "loop_max_us", "requests",
+  "request_failures", "request_avg_ms", "tls_avg_ms", "wifi_reconnects", "held_alerts",
+};
+
+struct MetricsSummary {
+  uint32_t values[SUMMARY_FIELD_COUNT];
+
+  void writeJson(JsonWriter& json) const {
+    json.beginObject();
+    for (uint8_t i = 0; i < SUMMARY_FIELD_COUNT; i++) {
+      json.field(METRICS_SUMMARY_NAMES[i], (unsigned long)values[i]);
+    }
+    json.endObject();
+  }
+};
@@ -0,0 +1,121 @@
+#pragma once
+// Supabase payload builders shared by the firmware and the host tools.
+// Everything is written through JsonWriter into caller-owned buffers.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "gas_detector.h"
+#include "json_writer.h"
+
+// Reading as uploaded (and as stored on flash); epoch is 0 when the clock
+// wasn't synced yet, in which case the database assigns created_at.
+struct StoredReading {
+  uint32_t epoch;
+  float gasLevel;
+  float gasMin;
+  float gasMax;
+  float gasMean;
+};
+
+inline void formatTimestamp(uint32_t epoch, char* buf, size_t size) {
+  time_t t = epoch;
+  struct tm utc;
+  gmtime_r(&t, &utc);
+  strftime(buf, size, "%Y-%m-%dT%H:%M:%SZ", &utc);
+}
+
+// One device_readings row; userId may be empty. Like created_at, the window
+// summary must be set on all rows of a bulk insert or on none. metrics is a
+// raw JSON value for the metrics column: the summary on a batch's first
+// row and "null" on the others, or nullptr to leave the column out.
+inline void buildReadingJson(JsonWriter& json, const char* deviceId, const char* userId, const StoredReading& reading,
+                             bool withTimestamp, bool withSummary, const char* metrics = nullptr) {
+  json.beginObject();
+  json.field("device_id", deviceId);
+  if (userId[0] != '\0') {
+    json.field("user_id", userId);
+  }
+  if (withTimestamp) {
+    char createdAt[25];
+    formatTimestamp(reading.epoch, createdAt, sizeof(createdAt));
+    json.field("created_at", createdAt);
+  }
+  json.field("temperature", 0);
+  json.field("humidity", 0);
+  json.field("pressure", 0);
+  json.field("gas_level", reading.gasLevel);
+  if (withSummary) {
+    json.field("gas_min", reading.gasMin);
+    json.field("gas_max", reading.gasMax);
+    json.field("gas_mean", reading.gasMean);
+  }
+  if (metrics) {
+    json.rawField("metrics", metrics);
+  }
+  json.endObject();
+}
+
+// Fills the message and sensor_data of a gas alert and returns its
+// alert_type. threshold is the level that was crossed.
+inline const char* buildGasAlert(GasTransition transition, float gasValue, float gasPercentage, float threshold,
+                                 char* message, size_t messageSize, JsonWriter& sensorData) {
+  sensorData.beginObject();
+  sensorData.field("gas_value", gasValue);
+  sensorData.field("gas_percentage", gasPercentage);
+
+  const char* alertType;
+  switch (transition) {
+    case TRANSITION_EMERGENCY:
+      snprintf(message, messageSize, "🚨 EMERGENCY: Gas leak detected! Value: %.2f", gasValue);
+      sensorData.field("threshold", threshold);
+      alertType = "gas_emergency";
+      break;
+    case TRANSITION_WARNING:
+      snprintf(message, messageSize, "⚠️ WARNING: Elevated gas levels. Value: %.2f", gasValue);
+      sensorData.field("warning_level", threshold);
+      alertType = "gas_warning";
+      break;
+    default:
+      snprintf(message, messageSize, "✅ ALL CLEAR: Gas levels normal");
+      alertType = "gas_normal";
+      break;
+  }
+
+  sensorData.endObject();
+  return alertType;
+}
+
+// alerts row; sensorData is already serialized JSON, userId and createdAt
+// may be empty. The insert policy needs user_id, so an unpaired device's
+// alerts are rejected.
+inline void buildAlertPayload(JsonWriter& json, const char* deviceId, const char* userId, const char* alertType,
+                              const char* message, const char* sensorData, const char* createdAt) {
+  json.beginObject();
+  json.field("device_id", deviceId);
+  if (userId[0] != '\0') {
+    json.field("user_id", userId);
+  }
+  json.field("alert_type", alertType);
+  if (createdAt[0] != '\0') {
+    json.field("created_at", createdAt);
+  }
+  json.field("message", message);
+  json.rawField("sensor_data", sensorData);
+  json.endObject();
+}
+
+// devices row created on first boot
+inline void buildDeviceRegistration(JsonWriter& json, const char* deviceId) {
+  char name[48];
+  snprintf(name, sizeof(name), "SmartGas Detector %s", strlen(deviceId) > 12 ? deviceId + 12 : deviceId);
+
+  json.beginObject();
+  json.field("id", deviceId);
+  json.field("name", name);
+  json.field("description", "ESP32 based gas leak detector");
+  json.field("location", "Unknown"); // Can be updated later via web interface
+  json.endObject();
+}
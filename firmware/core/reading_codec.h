@@ -0,0 +1,229 @@
+#pragma once
+// Compact binary encoding of a device_readings batch. The decoder lives in
+// supabase/functions/_shared/reading_codec.ts, used by the ingest-readings
+// edge function and the MQTT bridge; ReadingBatchDecoder below mirrors it
+// for the host tools.
+// IDs are sent once per batch and the always-zero columns not at all. Values
+// are quantised to 0.1 ADC counts and sent as zigzag varint deltas. A row
+// then costs 2-8 bytes instead of ~200 bytes of JSON.
+//
+//   'G' 0x01              magic, format version
+//   flags                 bit 0: created_at present, bit 1: window summary present,
+//                         bit 2: metrics summary present
+//   str device_id         varint length + bytes
+//   str user_id           may be empty
+//   [varint n, varint x n] MetricsSummary values by position (bit 2), stored
+//                         on the batch's first row
+//   varint count
+//   count x row:
+//     [svarint]           epoch seconds, delta from the previous row (bit 0)
+//     svarint             gas_level, delta from the previous row's gas_level
+//     [svarint x3]        gas_min, gas_max, gas_mean, delta from this row's gas_level (bit 1)
+//
+// The first row's deltas are taken from 0. svarint is a zigzag-encoded
+// signed varint (LEB128, 7 bits per byte, least significant group first).
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "metrics.h"
+#include "payloads.h"
+
+#define READING_CODEC_MAGIC 'G'
+#define READING_CODEC_VERSION 1
+#define READING_CODEC_TIMESTAMPS 0x01
+#define READING_CODEC_SUMMARY 0x02
+#define READING_CODEC_METRICS 0x04
+#define READING_CODEC_SCALE 10 // Units per ADC count
+
+// Byte counterpart of JsonWriter: writes into a caller-owned buffer and
+// remembers overflow instead of failing each call
+struct BinaryWriter {
+  uint8_t* buf;
+  size_t capacity;
+  size_t length;
+  bool overflow;
+
+  BinaryWriter(uint8_t* buffer, size_t size) : buf(buffer), capacity(size), length(0), overflow(false) {}
+
+  void put(uint8_t byte) {
+    if (length < capacity) buf[length++] = byte;
+    else overflow = true;
+  }
+
+  void varint(uint32_t value) {
+    while (value >= 0x80) {
+      put((uint8_t)(value | 0x80));
+      value >>= 7;
+    }
+    put((uint8_t)value);
+  }
+
+  void svarint(int32_t value) {
+    varint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+  }
+
+  void string(const char* value) {
+    size_t n = strlen(value);
+    varint((uint32_t)n);
+    for (size_t i = 0; i < n; i++) put((uint8_t)value[i]);
+  }
+
+  bool ok() const { return !overflow; }
+  const uint8_t* data() const { return buf; }
+  size_t size() const { return length; }
+};
+
+inline int32_t quantizeReading(float value) {
+  return (int32_t)lroundf(value * READING_CODEC_SCALE);
+}
+
+// Writes the header, then one add() per row; the row count is fixed up front
+struct ReadingBatchEncoder {
+  BinaryWriter& out;
+  uint8_t flags;
+  uint32_t prevEpoch;
+  int32_t prevLevel;
+
+  ReadingBatchEncoder(BinaryWriter& writer) : out(writer), flags(0), prevEpoch(0), prevLevel(0) {}
+
+  void begin(const char* deviceId, const char* userId, uint16_t count, bool withTimestamp, bool withSummary,
+             const MetricsSummary* metrics = nullptr) {
+    flags = (withTimestamp ? READING_CODEC_TIMESTAMPS : 0) | (withSummary ? READING_CODEC_SUMMARY : 0) |
+            (metrics ? READING_CODEC_METRICS : 0);
+    out.put(READING_CODEC_MAGIC);
+    out.put(READING_CODEC_VERSION);
+    out.put(flags);
+    out.string(deviceId);
+    out.string(userId);
+    if (metrics) {
+      out.varint(SUMMARY_FIELD_COUNT);
+      for (uint8_t i = 0; i < SUMMARY_FIELD_COUNT; i++) out.varint(metrics->values[i]);
+    }
+    out.varint(count);
+  }
+
+  void add(const StoredReading& reading) {
+    if (flags & READING_CODEC_TIMESTAMPS) {
+      out.svarint((int32_t)(reading.epoch - prevEpoch));
+      prevEpoch = reading.epoch;
+    }
+    int32_t level = quantizeReading(reading.gasLevel);
+    out.svarint(level - prevLevel);
+    prevLevel = level;
+    if (flags & READING_CODEC_SUMMARY) {
+      out.svarint(quantizeReading(reading.gasMin) - level);
+      out.svarint(quantizeReading(reading.gasMax) - level);
+      out.svarint(quantizeReading(reading.gasMean) - level);
+    }
+  }
+};
+
+// Counterpart of decodeBatch() in reading_codec.ts, with the same limits,
+// for host tools that accept batches. begin() reads the header, then each
+// next() one row; both return false on a malformed batch, and done() tells
+// whether the body ended with the last row. Without the summary flag a
+// row's gasMin/gasMax/gasMean are left at its gasLevel.
+#define READING_CODEC_MAX_ROWS 1000
+#define READING_CODEC_MAX_METRICS 64
+
+struct ReadingBatchDecoder {
+  const uint8_t* p;
+  const uint8_t* end;
+  uint8_t flags;
+  char deviceId[64];
+  char userId[64];
+  MetricsSummary metrics;   // Fields beyond SUMMARY_FIELD_COUNT are skipped
+  uint32_t count;
+  uint32_t rowsRead;
+  uint32_t epoch;
+  int32_t level;
+
+  ReadingBatchDecoder(const uint8_t* data, size_t size)
+    : p(data), end(data + size), flags(0), count(0), rowsRead(0), epoch(0), level(0) {
+    deviceId[0] = userId[0] = '\0';
+    memset(&metrics, 0, sizeof(metrics));
+  }
+
+  bool byte(uint8_t& value) {
+    if (p >= end) return false;
+    value = *p++;
+    return true;
+  }
+
+  bool varint(uint32_t& value) {
+    uint64_t result = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+      uint8_t b;
+      if (!byte(b)) return false;
+      result |= (uint64_t)(b & 0x7F) << shift;
+      if ((b & 0x80) == 0) {
+        value = (uint32_t)result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool svarint(int32_t& value) {
+    uint32_t raw;
+    if (!varint(raw)) return false;
+    value = (int32_t)(raw >> 1) ^ -(int32_t)(raw & 1);
+    return true;
+  }
+
+  bool string(char* out, size_t size) {
+    uint32_t length;
+    if (!varint(length) || length > (uint32_t)(end - p) || length >= size) return false;
+    memcpy(out, p, length);
+    out[length] = '\0';
+    p += length;
+    return true;
+  }
+
+  bool begin() {
+    uint8_t magic, version;
+    if (!byte(magic) || magic != READING_CODEC_MAGIC) return false;
+    if (!byte(version) || version != READING_CODEC_VERSION) return false;
+    if (!byte(flags) || !string(deviceId, sizeof(deviceId)) || !string(userId, sizeof(userId))) return false;
+    if (flags & READING_CODEC_METRICS) {
+      uint32_t fields;
+      if (!varint(fields) || fields > READING_CODEC_MAX_METRICS) return false;
+      for (uint32_t i = 0; i < fields; i++) {
+        uint32_t value;
+        if (!varint(value)) return false;
+        if (i < SUMMARY_FIELD_COUNT) metrics.values[i] = value;
+      }
+    }
+    if (!varint(count)) return false;
+    return deviceId[0] != '\0' && count <= READING_CODEC_MAX_ROWS;
+  }
+
+  // Deltas are accumulated in the quantised domain, exactly as encoded
+  bool next(StoredReading& row) {
+    if (rowsRead == count) return false;
+    int32_t delta;
+    if (flags & READING_CODEC_TIMESTAMPS) {
+      if (!svarint(delta)) return false;
+      epoch += (uint32_t)delta;
+    }
+    if (!svarint(delta)) return false;
+    level += delta;
+    row.epoch = epoch;
+    row.gasLevel = (float)level / READING_CODEC_SCALE;
+    row.gasMin = row.gasMax = row.gasMean = row.gasLevel;
+    if (flags & READING_CODEC_SUMMARY) {
+      int32_t low, high, mean;
+      if (!svarint(low) || !svarint(high) || !svarint(mean)) return false;
+      row.gasMin = (float)(level + low) / READING_CODEC_SCALE;
+      row.gasMax = (float)(level + high) / READING_CODEC_SCALE;
+      row.gasMean = (float)(level + mean) / READING_CODEC_SCALE;
+    }
+    rowsRead++;
+    return true;
+  }
+
+  bool done() const { return rowsRead == count && p == end; }
+};
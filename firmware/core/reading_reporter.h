@@ -0,0 +1,54 @@
+#pragma once
+// Report-on-change for device_readings. The sensing task asks due() once per
+// reading interval. A reading is only queued when one of these holds:
+// - the window mean moved `deadband` away from the last reported value;
+// - a window min/max excursion moved `excursion` away from it;
+// - nothing was reported for `heartbeat` ms.
+// Skipped intervals keep accumulating in the window, so the next row's
+// min/max/mean cover everything since the previous one.
+
+#include <stdint.h>
+
+#include "gas_filter.h"
+
+// Settings of a reporter, set by name; the rest of ReadingReporter is state
+struct ReadingReporterConfig {
+  float deadband;     // Filtered ADC counts; 0 reports every interval
+  float excursion;    // Wider band for brief peaks/dips inside the window
+  uint32_t heartbeat; // Longest gap between rows (ms)
+  bool summaries;     // Upload window min/max/mean with each row
+};
+
+struct ReadingReporter {
+  ReadingReporterConfig config;
+  bool started;       // A row was reported since boot
+  float lastValue;    // Value of the last reported row
+  uint32_t lastReport;
+  uint32_t reported;
+  uint32_t skipped;
+
+  explicit ReadingReporter(const ReadingReporterConfig& settings)
+    : config(settings), started(false), lastValue(0), lastReport(0), reported(0), skipped(0) {}
+
+  bool due(float value, const GasWindow& window, uint32_t now) {
+    bool changed = !started || config.deadband <= 0;
+    if (!changed && window.count > 0) {
+      changed = distance(window.mean()) >= config.deadband || distance(window.min) >= config.excursion ||
+                distance(window.max) >= config.excursion;
+    }
+    if (!changed && now - lastReport < config.heartbeat) {
+      skipped++;
+      return false;
+    }
+
+    started = true;
+    lastValue = value;
+    lastReport = now;
+    reported++;
+    return true;
+  }
+
+  float distance(float value) const {
+    return value > lastValue ? value - lastValue : lastValue - value;
+  }
+};
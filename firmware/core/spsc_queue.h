@@ -0,0 +1,34 @@
+#pragma once
+// Lock-free single-producer/single-consumer ring buffer. One slot is kept
+// free to tell full from empty, so it holds at most N - 1 items.
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint16_t N>
+struct SpscQueue {
+  T items[N];
+  std::atomic<uint16_t> head{0}; // Next slot to write (producer)
+  std::atomic<uint16_t> tail{0}; // Next slot to read (consumer)
+
+  bool push(const T& item) {
+    uint16_t h = head.load(std::memory_order_relaxed);
+    uint16_t next = (h + 1) % N;
+    if (next == tail.load(std::memory_order_acquire)) return false; // Full
+    items[h] = item;
+    head.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    uint16_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false; // Empty
+    item = items[t];
+    tail.store((t + 1) % N, std::memory_order_release);
+    return true;
+  }
+
+  uint16_t size() const {
+    return (head.load(std::memory_order_acquire) + N - tail.load(std::memory_order_acquire)) % N;
+  }
+};
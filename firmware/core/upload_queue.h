@@ -0,0 +1,280 @@
+#pragma once
+// Upload side of the firmware, run by the network task: sensor events are
+// drained into two alert lanes and a reading ring, and uploadPass() sends
+// from them in a fixed order. Emergencies get a lane of their own that is
+// sent before any other alert or reading batch, and retried on its own
+// short backoff until the backend acknowledges or rejects them.
+//
+// Requests go through an UploadBackend. The sketch sends over HTTPS or MQTT
+// and replays records parked in flash; the host simulator posts to its
+// Supabase stand-in. Both run the queueing, retry and drop rules below.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "firmware_constants.h"
+#include "gas_sensing.h"
+#include "histogram.h"
+#include "json_writer.h"
+#include "payloads.h"
+
+// Outcome of an upload. No answer, a 5xx, 408 or 429 may go through on a
+// later try; any other 4xx (bad row, foreign key, RLS) never will.
+enum SendResult : uint8_t {
+  SEND_OK,
+  SEND_RETRY,
+  SEND_REJECTED
+};
+
+inline SendResult classifyResponse(bool sent, int httpCode, int expected) {
+  if (sent && httpCode == expected) return SEND_OK;
+  if (!sent || httpCode >= 500 || httpCode == 408 || httpCode == 429 || httpCode < 400) return SEND_RETRY;
+  return SEND_REJECTED;
+}
+
+// Retry delay that doubles per failure from minDelay up to maxDelay and
+// is cleared by the next success
+struct RetryBackoff {
+  uint32_t minDelay;
+  uint32_t maxDelay;
+  uint32_t delay;       // 0 unless the last attempt failed
+  uint32_t lastFailure;
+
+  void fail(uint32_t now) {
+    delay = delay == 0 ? minDelay : (delay * 2 < maxDelay ? delay * 2 : maxDelay);
+    lastFailure = now;
+  }
+  void succeed() { delay = 0; }
+  bool waiting(uint32_t now) const { return delay > 0 && now - lastFailure < delay; }
+};
+
+struct PendingAlert {
+  uint32_t timestamp; // millis() when the alert was raised
+  char alertType[ALERT_TYPE_SIZE];
+  char message[ALERT_MESSAGE_SIZE];
+  char sensorData[ALERT_SENSOR_DATA_SIZE]; // Serialized JSON object
+};
+
+struct AlertLane {
+  PendingAlert* alerts;
+  uint8_t capacity;
+  uint8_t head;
+  uint8_t count;
+
+  PendingAlert& front() { return alerts[head]; }
+  void pop() {
+    head = (head + 1) % capacity;
+    count--;
+  }
+};
+
+struct BufferedReading {
+  uint32_t timestamp; // millis() when the sample was taken
+  float gasLevel;
+  float gasMin;       // Window statistics since the previous reading
+  float gasMax;
+  float gasMean;
+};
+
+struct UploadBackend {
+  void* context;
+  uint32_t (*clock)(); // millis()
+  SendResult (*sendAlert)(const PendingAlert& alert, void* context);
+  SendResult (*sendReadings)(const BufferedReading* rows, uint16_t count, void* context);
+  // Offline store, may be null: replays its oldest record and returns
+  // true, or returns false when nothing is stored
+  bool (*replayAlert)(void* context);
+  bool (*replayReadings)(void* context);
+};
+
+struct UploadQueue {
+  UploadBackend backend;
+
+  PendingAlert urgentSlots[URGENT_ALERT_CAPACITY];
+  PendingAlert pendingSlots[PENDING_ALERT_CAPACITY];
+  AlertLane urgentAlerts;
+  AlertLane pendingAlerts;
+  uint32_t alertsDropped;  // Pushed out of a full lane
+  uint32_t alertsRejected; // Refused by the backend with a 4xx, never retried
+  RetryBackoff urgentBackoff;
+  uint32_t urgentRetries;
+  Histogram<9> alertLatency; // Detection to acknowledgement (ms)
+
+  BufferedReading readings[READING_BUFFER_CAPACITY];
+  uint16_t readingHead;    // Index of the oldest queued reading
+  uint16_t readingCount;
+  uint32_t readingsDropped;
+  uint32_t readingsRejected; // Refused by the backend with a 4xx, never retried
+  uint32_t readingBatchesSent;
+  uint32_t lastFlushAttempt;
+  volatile bool flushRequested; // Set by the flush_readings command
+
+  explicit UploadQueue(const UploadBackend& uploadBackend) : backend(uploadBackend) {
+    urgentAlerts = { urgentSlots, URGENT_ALERT_CAPACITY, 0, 0 };
+    pendingAlerts = { pendingSlots, PENDING_ALERT_CAPACITY, 0, 0 };
+    alertsDropped = alertsRejected = 0;
+    urgentBackoff = { URGENT_RETRY_MIN, URGENT_RETRY_MAX, 0, 0 };
+    urgentRetries = 0;
+    memset(&alertLatency, 0, sizeof(alertLatency));
+    alertLatency.bounds = ALERT_LATENCY_BOUNDS;
+    readingHead = readingCount = 0;
+    readingsDropped = readingsRejected = readingBatchesSent = 0;
+    lastFlushAttempt = 0;
+    flushRequested = false;
+  }
+
+  // Moves readings and alert events from the sensing core into the queues
+  void drain(SensorEventQueue& events) {
+    SensorEvent event;
+    while (events.pop(event)) {
+      if (event.type == EVENT_READING) {
+        queueReading(event);
+        continue;
+      }
+
+      char message[ALERT_MESSAGE_SIZE];
+      char sensorData[ALERT_SENSOR_DATA_SIZE];
+      JsonWriter json(sensorData, sizeof(sensorData));
+      const char* alertType = buildGasAlert(event.transition, event.gasValue, event.gasPercentage, event.threshold,
+                                            message, sizeof(message), json);
+      bool urgent = event.transition == TRANSITION_EMERGENCY;
+      queueAlert(urgent ? urgentAlerts : pendingAlerts, alertType, message, sensorData, event.timestamp);
+    }
+  }
+
+  // ==================== ALERTS ====================
+  void queueAlert(AlertLane& lane, const char* alertType, const char* message, const char* sensorData, uint32_t timestamp) {
+    if (lane.count == lane.capacity) {
+      lane.pop();
+      alertsDropped++;
+    }
+    PendingAlert& alert = lane.alerts[(lane.head + lane.count) % lane.capacity];
+    alert.timestamp = timestamp;
+    snprintf(alert.alertType, sizeof(alert.alertType), "%s", alertType);
+    snprintf(alert.message, sizeof(alert.message), "%s", message);
+    snprintf(alert.sensorData, sizeof(alert.sensorData), "%s", sensorData);
+    lane.count++;
+  }
+
+  // Sends the oldest alert of a lane. It stays queued if the request may go
+  // through later and is dropped if the backend rejected it.
+  bool sendQueuedAlert(AlertLane& lane) {
+    if (lane.count == 0) return true;
+    PendingAlert& alert = lane.front();
+    SendResult result = backend.sendAlert(alert, backend.context);
+    if (result == SEND_RETRY) {
+      return false;
+    }
+    if (result == SEND_OK) {
+      alertLatency.add(backend.clock() - alert.timestamp);
+    } else {
+      alertsRejected++;
+    }
+    lane.pop();
+    return true;
+  }
+
+  // Sends queued emergencies until one fails, then retries after a delay
+  // that doubles per failure, from URGENT_RETRY_MIN up to URGENT_RETRY_MAX.
+  // Only transient failures are retried; a rejected alert is dropped.
+  void sendUrgentAlerts() {
+    if (urgentBackoff.waiting(backend.clock())) return;
+    while (urgentAlerts.count > 0) {
+      if (!sendQueuedAlert(urgentAlerts)) {
+        urgentBackoff.fail(backend.clock());
+        urgentRetries++;
+        return;
+      }
+      urgentBackoff.succeed();
+    }
+  }
+
+  // ==================== READINGS ====================
+  void queueReading(const SensorEvent& event) {
+    if (readingCount == READING_BUFFER_CAPACITY) {
+      // Buffer full (backend unreachable): drop the oldest reading
+      dropReadings(1);
+      readingsDropped++;
+    }
+    BufferedReading& reading = readings[(readingHead + readingCount) % READING_BUFFER_CAPACITY];
+    reading.timestamp = event.timestamp;
+    reading.gasLevel = event.gasValue;
+    reading.gasMin = event.gasMin;
+    reading.gasMax = event.gasMax;
+    reading.gasMean = event.gasMean;
+    readingCount++;
+  }
+
+  // Copies up to max of the oldest readings, leaving them queued
+  uint16_t peekReadings(BufferedReading* out, uint16_t max) const {
+    uint16_t count = readingCount < max ? readingCount : max;
+    for (uint16_t i = 0; i < count; i++) {
+      out[i] = readings[(readingHead + i) % READING_BUFFER_CAPACITY];
+    }
+    return count;
+  }
+
+  void dropReadings(uint16_t count) {
+    readingHead = (readingHead + count) % READING_BUFFER_CAPACITY;
+    readingCount -= count;
+  }
+
+  // A full batch, or an old enough reading, and no recent failed flush
+  bool readingsDue() const {
+    if (readingCount == 0) return false;
+    uint32_t now = backend.clock();
+    if (lastFlushAttempt != 0 && now - lastFlushAttempt < READING_FLUSH_RETRY) return false;
+    if (readingCount >= READING_BATCH_SIZE) return true;
+    return now - readings[readingHead].timestamp >= READING_BATCH_MAX_AGE;
+  }
+
+  // Sends the oldest READING_UPLOAD_MAX readings as one batch
+  bool flushReadings() {
+    if (readingCount == 0) return true;
+    lastFlushAttempt = backend.clock();
+
+    BufferedReading rows[READING_UPLOAD_MAX];
+    uint16_t count = peekReadings(rows, READING_UPLOAD_MAX);
+    SendResult result = backend.sendReadings(rows, count, backend.context);
+    if (result == SEND_RETRY) {
+      return false;
+    }
+    // Readings queued while the request was in flight stay in the buffer
+    dropReadings(count);
+    if (result == SEND_REJECTED) {
+      // Resending the same rows would be rejected again
+      readingsRejected += count;
+      return false;
+    }
+    readingBatchesSent++;
+    lastFlushAttempt = 0;
+    return true;
+  }
+
+  // ==================== UPLOAD PASS ====================
+  // One pass of the upload task, once the device is online and registered.
+  // backingOff is true while failed requests are being waited out.
+  void uploadPass(bool backingOff) {
+    // Emergencies jump the queue and keep their own retry schedule; nothing
+    // else is sent until they're through
+    if (urgentAlerts.count > 0) {
+      sendUrgentAlerts();
+      return;
+    }
+    if (backingOff) return;
+
+    // One request per pass keeps the time spent in the network bounded.
+    // Stored alerts are older than queued ones, so they go first.
+    if (backend.replayAlert != nullptr && backend.replayAlert(backend.context)) return;
+    if (pendingAlerts.count > 0) {
+      sendQueuedAlert(pendingAlerts);
+      return;
+    }
+    if (backend.replayReadings != nullptr && backend.replayReadings(backend.context)) return;
+    if (flushRequested || readingsDue()) {
+      flushRequested = false;
+      flushReadings();
+    }
+  }
+};
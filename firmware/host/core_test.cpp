@@ -0,0 +1,784 @@
+// Unit tests for the portable core (firmware/core), run by ctest. Each
+// suite is one ctest case; without an argument every suite runs.
+//
+//   ./core_test [suite]
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "device_config.h"
+#include "firmware_constants.h"
+#include "gas_baseline.h"
+#include "gas_detector.h"
+#include "gas_filter.h"
+#include "gas_sensing.h"
+#include "json_reader.h"
+#include "json_writer.h"
+#include "metrics.h"
+#include "payloads.h"
+#include "reading_codec.h"
+#include "reading_reporter.h"
+#include "upload_queue.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                      \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  ❌ %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+#define CHECK_STR(actual, expected) CHECK(strcmp((actual), (expected)) == 0)
+
+// ==================== JSON READER ====================
+static bool parse(const char* json, JsonField* fields, uint8_t count) {
+  return parseJsonFields(json, strlen(json), fields, count);
+}
+
+static void testJsonReader() {
+  char name[32], ratio[16], enabled[8], location[16];
+  JsonField fields[] = {
+    { "name", name, sizeof(name), false },
+    { "ratio", ratio, sizeof(ratio), false },
+    { "enabled", enabled, sizeof(enabled), false },
+    { "location", location, sizeof(location), false },
+  };
+
+  // Strings are unescaped, literals copied as text, unknown keys skipped
+  CHECK(parse("{\"name\":\"a\\\"b\\\\c\\/d\\n\",\"skip\":{\"x\":[1,\"}\"]},\"ratio\":1.25,\"enabled\":true}", fields, 4));
+  CHECK(fields[0].found);
+  CHECK_STR(name, "a\"b\\c/d\n");
+  CHECK(fields[1].found);
+  CHECK_STR(ratio, "1.25");
+  CHECK(fields[2].found);
+  CHECK_STR(enabled, "true");
+  CHECK(!fields[3].found);
+
+  // \u escapes become UTF-8
+  CHECK(parse("{\"name\":\"caf\\u00e9 \\u20ac\"}", fields, 4));
+  CHECK(fields[0].found);
+  CHECK_STR(name, "caf\xC3\xA9 \xE2\x82\xAC");
+
+  // null counts as absent, in both string and literal fields
+  CHECK(parse("{\"name\":null, \"ratio\" : null, \"location\":\"Kitchen\"}", fields, 4));
+  CHECK(!fields[0].found);
+  CHECK_STR(name, "");
+  CHECK(!fields[1].found);
+  CHECK_STR(ratio, "");
+  CHECK(fields[3].found);
+  CHECK_STR(location, "Kitchen");
+
+  // PostgREST result sets: the first row, or nothing
+  CHECK(parse("[{\"location\":\"Hall\"},{\"location\":\"Attic\"}]", fields, 4));
+  CHECK_STR(location, "Hall");
+  CHECK(parse("[]", fields, 4));
+  CHECK(!fields[3].found);
+
+  // A value that doesn't fit is not found
+  CHECK(parse("{\"location\":\"A very long location name\"}", fields, 4));
+  CHECK(!fields[3].found);
+
+  // Malformed or oversized documents fail
+  CHECK(!parse("{\"name\":\"unterminated}", fields, 4));
+  CHECK(!parse("{\"name\" \"x\"}", fields, 4));
+  CHECK(!parse("{\"name\":\"x\"", fields, 4));
+  CHECK(!parse("\"name\"", fields, 4));
+  char big[JSON_MAX_BODY + 16];
+  memset(big, ' ', sizeof(big) - 1);
+  big[0] = '{';
+  big[sizeof(big) - 2] = '}';
+  big[sizeof(big) - 1] = '\0';
+  CHECK(!parse(big, fields, 4));
+}
+
+// ==================== JSON WRITER ====================
+static void testJsonWriter() {
+  char buf[128];
+  JsonWriter json(buf, sizeof(buf));
+  json.beginObject();
+  json.field("type", "gas \"leak\"\n");
+  json.field("level", 312.456, 1);
+  json.field("ok", true);
+  json.field("count", 3);
+  json.key("none");
+  json.value((const char*)nullptr);
+  json.field("nan", (double)NAN);
+  json.key("list");
+  json.beginArray();
+  json.value(1);
+  json.raw("{\"a\":1}");
+  json.endArray();
+  json.endObject();
+  CHECK(json.ok());
+  CHECK_STR(json.c_str(), "{\"type\":\"gas \\\"leak\\\"\\n\",\"level\":312.5,\"ok\":true,\"count\":3,"
+                          "\"none\":null,\"nan\":null,\"list\":[1,{\"a\":1}]}");
+  CHECK(json.size() == strlen(buf));
+
+  // Exactly full: the terminator still fits
+  char exact[8];
+  JsonWriter fits(exact, sizeof(exact));
+  fits.value("abcde");
+  CHECK(fits.ok());
+  CHECK_STR(exact, "\"abcde\"");
+
+  // Overflow is remembered, the output is truncated but terminated
+  char small[16];
+  memset(small, 'x', sizeof(small));
+  JsonWriter overflow(small, sizeof(small));
+  overflow.beginObject();
+  overflow.field("message", "this does not fit");
+  overflow.field("more", 1);
+  overflow.endObject();
+  CHECK(!overflow.ok());
+  CHECK(overflow.size() == sizeof(small) - 1);
+  CHECK(small[sizeof(small) - 1] == '\0');
+  CHECK(strncmp(small, "{\"message\":\"thi", sizeof(small) - 1) == 0);
+
+  // A number that would be cut short marks the overflow too
+  char tiny[4];
+  JsonWriter number(tiny, sizeof(tiny));
+  number.value(123456L);
+  CHECK(!number.ok());
+  CHECK_STR(tiny, "123");
+}
+
+// ==================== READING CODEC ====================
+static bool sameReading(const StoredReading& a, const StoredReading& b) {
+  return a.epoch == b.epoch && quantizeReading(a.gasLevel) == quantizeReading(b.gasLevel) &&
+         quantizeReading(a.gasMin) == quantizeReading(b.gasMin) &&
+         quantizeReading(a.gasMax) == quantizeReading(b.gasMax) &&
+         quantizeReading(a.gasMean) == quantizeReading(b.gasMean);
+}
+
+static void testReadingCodec() {
+  uint8_t buf[256];
+
+  // Golden bytes, worked out by hand from the format in reading_codec.h and
+  // decodeBatch() in supabase/functions/_shared/reading_codec.ts
+  {
+    BinaryWriter out(buf, sizeof(buf));
+    ReadingBatchEncoder encoder(out);
+    encoder.begin("D1", "u", 2, false, true);
+    encoder.add({ 0, 9.0f, 8.5f, 9.2f, 9.1f });
+    encoder.add({ 0, 10.5f, 10.5f, 10.5f, 10.5f });
+    const uint8_t expected[] = {
+      0x47, 0x01, 0x02,             // 'G', version 1, window summary
+      0x02, 'D', '1', 0x01, 'u',    // device_id, user_id
+      0x02,                         // count
+      0xB4, 0x01, 0x09, 0x04, 0x02, // 90 -> zigzag 180; min -5, max +2, mean +1
+      0x1E, 0x00, 0x00, 0x00,       // +15; min/max/mean at gas_level
+    };
+    CHECK(out.ok());
+    CHECK(out.size() == sizeof(expected));
+    CHECK(memcmp(out.data(), expected, sizeof(expected)) == 0);
+  }
+
+  // Round trip with timestamps, negative deltas and a metrics summary
+  const StoredReading rows[] = {
+    { 1700000000, 90.04f, 88.5f, 91.26f, 90.1f },
+    { 1700000005, 89.5f, 89.5f, 89.5f, 89.5f },
+    { 1699999990, 412.3f, 95.0f, 4095.0f, 250.75f }, // Clock stepped back
+    { 1700000300, 0.0f, 0.0f, 0.0f, 0.0f },
+  };
+  const uint16_t count = sizeof(rows) / sizeof(rows[0]);
+  MetricsSummary metrics;
+  for (uint8_t i = 0; i < SUMMARY_FIELD_COUNT; i++) metrics.values[i] = i * 1000 + 7;
+  metrics.values[0] = 0xFFFFFFFF;
+
+  BinaryWriter out(buf, sizeof(buf));
+  ReadingBatchEncoder encoder(out);
+  encoder.begin("ESP32-A1B2C3D4E5F6", "0b7e2a34-5f1c-4c55-9c1e-6a0b8f7d2e11", count, true, true, &metrics);
+  for (uint16_t i = 0; i < count; i++) encoder.add(rows[i]);
+  CHECK(out.ok());
+
+  ReadingBatchDecoder decoder(out.data(), out.size());
+  CHECK(decoder.begin());
+  CHECK(decoder.flags == (READING_CODEC_TIMESTAMPS | READING_CODEC_SUMMARY | READING_CODEC_METRICS));
+  CHECK_STR(decoder.deviceId, "ESP32-A1B2C3D4E5F6");
+  CHECK_STR(decoder.userId, "0b7e2a34-5f1c-4c55-9c1e-6a0b8f7d2e11");
+  CHECK(memcmp(decoder.metrics.values, metrics.values, sizeof(metrics.values)) == 0);
+  CHECK(decoder.count == count);
+  StoredReading row = {};
+  for (uint16_t i = 0; i < count; i++) {
+    CHECK(decoder.next(row));
+    CHECK(sameReading(row, rows[i]));
+  }
+  CHECK(!decoder.next(row));
+  CHECK(decoder.done());
+
+  // Without the summary flag the window columns come back as gas_level
+  BinaryWriter plain(buf, sizeof(buf));
+  ReadingBatchEncoder plainEncoder(plain);
+  plainEncoder.begin("D1", "", 1, false, false);
+  plainEncoder.add(rows[0]);
+  ReadingBatchDecoder plainDecoder(plain.data(), plain.size());
+  CHECK(plainDecoder.begin());
+  CHECK_STR(plainDecoder.userId, "");
+  CHECK(plainDecoder.next(row));
+  CHECK(row.epoch == 0);
+  CHECK(quantizeReading(row.gasLevel) == 900);
+  CHECK(quantizeReading(row.gasMin) == 900 && quantizeReading(row.gasMean) == 900);
+  CHECK(plainDecoder.done());
+
+  // Malformed batches are refused, as decodeBatch() throws for them
+  ReadingBatchDecoder truncated(out.data(), out.size() - 1);
+  CHECK(truncated.begin());
+  bool complete = true;
+  for (uint16_t i = 0; i < count && complete; i++) complete = truncated.next(row);
+  CHECK(!complete);
+  uint8_t badMagic[] = { 'X', 0x01, 0x00, 0x01, 'D', 0x00, 0x00 };
+  CHECK(!ReadingBatchDecoder(badMagic, sizeof(badMagic)).begin());
+  uint8_t badVersion[] = { 'G', 0x02, 0x00, 0x01, 'D', 0x00, 0x00 };
+  CHECK(!ReadingBatchDecoder(badVersion, sizeof(badVersion)).begin());
+  uint8_t noDevice[] = { 'G', 0x01, 0x00, 0x00, 0x00, 0x00 };
+  CHECK(!ReadingBatchDecoder(noDevice, sizeof(noDevice)).begin());
+  uint8_t tooMany[] = { 'G', 0x01, 0x00, 0x01, 'D', 0x00, 0xE9, 0x07 }; // 1001 rows
+  CHECK(!ReadingBatchDecoder(tooMany, sizeof(tooMany)).begin());
+  uint8_t trailing[] = { 'G', 0x01, 0x00, 0x01, 'D', 0x00, 0x01, 0x02, 0x00 };
+  ReadingBatchDecoder trailingDecoder(trailing, sizeof(trailing));
+  CHECK(trailingDecoder.begin());
+  CHECK(trailingDecoder.next(row));
+  CHECK(!trailingDecoder.done());
+
+  // A batch that doesn't fit the buffer is flagged, not truncated silently
+  uint8_t small[8];
+  BinaryWriter overflow(small, sizeof(small));
+  ReadingBatchEncoder overflowEncoder(overflow);
+  overflowEncoder.begin("ESP32-A1B2C3D4E5F6", "", 1, false, false);
+  CHECK(!overflow.ok());
+  CHECK(overflow.size() == sizeof(small));
+}
+
+// ==================== DEVICE CONFIG ====================
+static void testDeviceConfig() {
+  // CRC-32 check value
+  const char* check = "123456789";
+  CHECK(DeviceConfig::deviceConfigCrc((const uint8_t*)check, strlen(check)) == 0xCBF43926);
+
+  static DeviceConfig saved, loaded;
+  saved.reset();
+  setConfigString(saved.deviceId, "ESP32-A1B2C3D4E5F6");
+  setConfigString(saved.ssid, "home-network-with-a-name-longer-than-32");
+  saved.lowPower = true;
+  setConfigString(saved.location, "Kitchen");
+  saved.remoteFields = REMOTE_THRESHOLD_RATIO;
+  saved.thresholdRatio = 1.8f;
+  saved.seal();
+  CHECK(saved.version == DEVICE_CONFIG_VERSION);
+  CHECK(saved.size == sizeof(DeviceConfig));
+  CHECK(strlen(saved.ssid) == sizeof(saved.ssid) - 1);
+
+  // setConfigString() zero-fills, so equal settings give equal CRCs
+  static DeviceConfig again;
+  again = saved;
+  memset(again.location, 'x', sizeof(again.location));
+  setConfigString(again.location, "Kitchen");
+  again.seal();
+  CHECK(again.crc == saved.crc);
+
+  loaded.reset();
+  CHECK(loaded.load((const uint8_t*)&saved, sizeof(saved)));
+  CHECK(memcmp(&loaded, &saved, sizeof(saved)) == 0);
+
+  // Any corrupted byte after the header fails the CRC
+  uint8_t blob[sizeof(DeviceConfig)];
+  memcpy(blob, &saved, sizeof(blob));
+  blob[offsetof(DeviceConfig, ssid)] ^= 0x01;
+  loaded.reset();
+  setConfigString(loaded.ssid, "untouched");
+  CHECK(!loaded.load(blob, sizeof(blob)));
+  CHECK_STR(loaded.ssid, "untouched");
+
+  // A torn write, a newer layout and a never-written blob are refused
+  memcpy(blob, &saved, sizeof(blob));
+  CHECK(!loaded.load(blob, sizeof(blob) - 1));
+  CHECK(!loaded.load(blob, DeviceConfig::headerSize() - 1));
+  uint16_t newer = DEVICE_CONFIG_VERSION + 1;
+  memcpy(blob + offsetof(DeviceConfig, version), &newer, sizeof(newer));
+  CHECK(!loaded.load(blob, sizeof(blob)));
+  memset(blob, 0, sizeof(blob));
+  CHECK(!loaded.load(blob, sizeof(blob)));
+
+  // A version 1 blob is its fields up to binaryReadings plus the struct's
+  // tail padding, which lands in location. That padding was never cleared
+  // on the device, so it may hold anything.
+  const size_t v1Size = 628;
+  CHECK(DeviceConfig::fieldsEnd(1) == 625);
+  CHECK(DeviceConfig::storedSize(1) == v1Size);
+  CHECK(DeviceConfig::storedSize(DEVICE_CONFIG_VERSION) == sizeof(DeviceConfig));
+  memcpy(blob, &saved, DeviceConfig::fieldsEnd(1));
+  memset(blob + DeviceConfig::fieldsEnd(1), 0x5A, v1Size - DeviceConfig::fieldsEnd(1));
+  uint16_t v1 = 1, v1Length = (uint16_t)v1Size;
+  uint32_t v1Crc = DeviceConfig::deviceConfigCrc(blob + DeviceConfig::headerSize(), v1Size - DeviceConfig::headerSize());
+  memcpy(blob + offsetof(DeviceConfig, version), &v1, sizeof(v1));
+  memcpy(blob + offsetof(DeviceConfig, size), &v1Length, sizeof(v1Length));
+  memcpy(blob + offsetof(DeviceConfig, crc), &v1Crc, sizeof(v1Crc));
+  memset(&loaded, 0xAA, sizeof(loaded));
+  CHECK(loaded.load(blob, v1Size));
+  CHECK(loaded.version == 1);
+  CHECK_STR(loaded.deviceId, "ESP32-A1B2C3D4E5F6");
+  CHECK_STR(loaded.ssid, saved.ssid);
+  CHECK(loaded.lowPower);
+  CHECK(memcmp(loaded.location, "\0\0\0\0", 4) == 0);
+  CHECK(loaded.remoteFields == 0);
+  CHECK(loaded.thresholdRatio == 0);
+  CHECK_STR(loaded.remoteUpdatedAt, "");
+
+  // Resealing upgrades it to the current version
+  loaded.seal();
+  CHECK(loaded.version == DEVICE_CONFIG_VERSION);
+  CHECK(again.load((const uint8_t*)&loaded, sizeof(loaded)));
+
+  // A version 1 blob of any other size is refused, as is one with a stale CRC
+  CHECK(!loaded.load(blob, DeviceConfig::fieldsEnd(1)));
+  blob[v1Size - 1] ^= 0x01;
+  CHECK(!loaded.load(blob, v1Size));
+}
+
+// ==================== GAS FILTER ====================
+static GasFilter makeFilter() {
+  GasFilter filter = { GAS_EMA_ALPHA, { 0, 0, 0 }, 0, 0, 0, { 0, 0, 0, 0 } };
+  return filter;
+}
+
+static void testGasFilter() {
+  // The first frame is taken as is
+  GasFilter filter = makeFilter();
+  CHECK(filter.update(100) == 100);
+  filter.update(100);
+  filter.update(100);
+  CHECK(filter.value == 100);
+
+  // A single-frame spike never gets past the median
+  CHECK(filter.update(1000) == 100);
+  CHECK(filter.update(100) == 100);
+  CHECK(filter.update(100) == 100);
+
+  // Two frames in a row do, and the EMA moves alpha of the way per frame
+  CHECK(filter.update(1000) == 100);
+  CHECK(fabsf(filter.update(1000) - (100 + GAS_EMA_ALPHA * 900)) < 0.01f);
+  float before = filter.value;
+  CHECK(fabsf(filter.update(1000) - (before + GAS_EMA_ALPHA * (1000 - before))) < 0.01f);
+  CHECK(filter.frames == 9);
+
+  // The window holds every filtered value since its reset
+  CHECK(filter.window.count == 9);
+  CHECK(filter.window.min == 100);
+  CHECK(filter.window.max == filter.value);
+  filter.window.reset();
+  CHECK(filter.window.count == 0 && filter.window.mean() == 0);
+  filter.update(1000);
+  CHECK(filter.window.count == 1 && filter.window.min == filter.value && filter.window.max == filter.value);
+
+  // After restart() the history is gone: the next frame is taken as is
+  filter.restart();
+  CHECK(filter.update(50) == 50);
+  CHECK(filter.window.count == 1 && filter.window.mean() == 50);
+}
+
+// ==================== GAS BASELINE ====================
+static void testGasBaseline() {
+  // 4 samples per block, 2 warm-up blocks; rises at 0.1, falls at 0.5 per block
+  GasBaseline baseline = { 4, 2, 0.1f, 0.5f, 1.1f, 0, 0, 0, 0, 0 };
+  CHECK(!baseline.ready());
+
+  // Warm-up: the plain mean of the blocks, reported once per block
+  CHECK(!baseline.update(100, false));
+  CHECK(!baseline.update(100, false));
+  CHECK(!baseline.update(100, false));
+  CHECK(baseline.update(100, false));
+  CHECK(baseline.value == 100 && !baseline.ready());
+  for (int i = 0; i < 3; i++) baseline.update(110, false);
+  CHECK(baseline.update(110, false));
+  CHECK(baseline.value == 105 && baseline.ready());
+
+  // A block above freezeRatio x baseline is a possible leak, never learned
+  for (int i = 0; i < 3; i++) baseline.update(200, false);
+  CHECK(!baseline.update(200, false));
+  CHECK(baseline.value == 105 && baseline.frozenBlocks == 1);
+
+  // So is a rise while the caller holds it (alarm active)
+  for (int i = 0; i < 3; i++) baseline.update(110, true);
+  CHECK(!baseline.update(110, true));
+  CHECK(baseline.value == 105 && baseline.frozenBlocks == 2);
+
+  // Rises are followed slowly, falls quickly, even while held
+  for (int i = 0; i < 3; i++) baseline.update(110, false);
+  CHECK(baseline.update(110, false));
+  CHECK(fabsf(baseline.value - 105.5f) < 0.001f);
+  for (int i = 0; i < 3; i++) baseline.update(95.5f, true);
+  CHECK(baseline.update(95.5f, true));
+  CHECK(fabsf(baseline.value - 100.5f) < 0.001f);
+  CHECK(baseline.blocks == 4);
+
+  // A restored baseline tracks at once; a reset warms up again
+  baseline.update(300, false); // Part of a block, dropped by restore()
+  baseline.restore(90);
+  CHECK(baseline.ready() && baseline.value == 90);
+  for (int i = 0; i < 3; i++) baseline.update(90, false);
+  CHECK(baseline.update(90, false));
+  CHECK(baseline.value == 90);
+  baseline.reset();
+  CHECK(!baseline.ready() && baseline.value == 0);
+}
+
+// ==================== GAS DETECTOR ====================
+// Feeds value once per SAMPLE_PERIOD for up to duration ms, stopping at the
+// first transition; now is left at that sample
+static GasTransition hold(GasDetector& detector, float value, uint32_t& now, uint32_t duration) {
+  for (uint32_t end = now + duration; now <= end; now += SAMPLE_PERIOD) {
+    GasTransition transition = detector.update(value, now);
+    if (transition != TRANSITION_NONE) return transition;
+  }
+  return TRANSITION_NONE;
+}
+
+static void testGasDetector() {
+  GasDetector detector(defaultDetectorConfig(), 150, 100);
+  detector.calibrate(100);
+  CHECK(fabsf(detector.threshold - 100 * GAS_THRESHOLD_RATIO) < 0.001f);
+  CHECK(fabsf(detector.warningLevel - 100 * GAS_WARNING_RATIO) < 0.001f);
+
+  // Clean air and a spike shorter than the emergency dwell change nothing
+  uint32_t now = 0;
+  CHECK(hold(detector, 100, now, 10000) == TRANSITION_NONE);
+  CHECK(hold(detector, 200, now, EMERGENCY_DWELL - SAMPLE_PERIOD) == TRANSITION_NONE);
+  CHECK(detector.update(100, now) == TRANSITION_NONE);
+  CHECK(detector.suppressed == 1);
+  CHECK(detector.state == STATE_NORMAL);
+
+  // A level that holds for its dwell time raises the alarm
+  now += SAMPLE_PERIOD;
+  uint32_t start = now;
+  CHECK(hold(detector, 200, now, 1000) == TRANSITION_EMERGENCY);
+  CHECK(now - start == EMERGENCY_DWELL);
+  CHECK(detector.notify && detector.alertActive());
+  uint32_t emergencyAt = now;
+
+  // Below the warning level but inside the hysteresis band: still an alarm
+  now += SAMPLE_PERIOD;
+  CHECK(hold(detector, 118, now, 10000) == TRANSITION_NONE);
+  CHECK(detector.alertActive());
+
+  // Below the band for the clear dwell: all clear, reported
+  start = now;
+  CHECK(hold(detector, 110, now, 10000) == TRANSITION_NORMAL);
+  CHECK(now - start == CLEAR_DWELL);
+  CHECK(detector.notify && detector.state == STATE_NORMAL);
+  uint32_t clearAt = now;
+
+  // A second emergency inside its cooldown is an escalation: reported
+  now += SAMPLE_PERIOD;
+  CHECK(hold(detector, 200, now, 1000) == TRANSITION_EMERGENCY);
+  CHECK(now - emergencyAt < ALERT_COOLDOWN);
+  CHECK(detector.notify);
+
+  // A second all-clear inside its cooldown is held back...
+  now += SAMPLE_PERIOD;
+  CHECK(hold(detector, 100, now, 10000) == TRANSITION_NORMAL);
+  CHECK(now - clearAt < ALERT_COOLDOWN);
+  CHECK(!detector.notify && detector.held == 1);
+  CHECK(!detector.mayReport(TRANSITION_NORMAL, now));
+  CHECK(detector.reportDue(now + 1000) == TRANSITION_NONE);
+
+  // ...and reported once the cooldown has run out, only once
+  CHECK(detector.mayReport(TRANSITION_NORMAL, clearAt + ALERT_COOLDOWN + 1));
+  CHECK(detector.reportDue(clearAt + ALERT_COOLDOWN + 1) == TRANSITION_NORMAL);
+  CHECK(detector.notify);
+  CHECK(detector.reportDue(clearAt + ALERT_COOLDOWN + 2) == TRANSITION_NONE);
+
+  // Warning after its own dwell, then straight on to the alarm
+  now = clearAt + ALERT_COOLDOWN + 1000;
+  start = now;
+  CHECK(hold(detector, 130, now, 5000) == TRANSITION_WARNING);
+  CHECK(now - start == WARNING_DWELL);
+  CHECK(detector.notify && detector.warningActive());
+  now += SAMPLE_PERIOD;
+  CHECK(hold(detector, 200, now, 1000) == TRANSITION_EMERGENCY);
+  CHECK(detector.notify);
+
+  // A warning that doesn't last its dwell is suppressed
+  GasDetector brief(defaultDetectorConfig(), 150, 120);
+  now = 0;
+  CHECK(hold(brief, 130, now, WARNING_DWELL - SAMPLE_PERIOD) == TRANSITION_NONE);
+  CHECK(brief.update(100, now) == TRANSITION_NONE);
+  CHECK(brief.suppressed == 1 && brief.state == STATE_NORMAL);
+}
+
+// ==================== READING REPORTER ====================
+static GasWindow windowOf(float min, float max, float mean) {
+  GasWindow window = { min, max, mean * 4, 4 };
+  return window;
+}
+
+static void testReadingReporter() {
+  ReadingReporter reporter(defaultReporterConfig());
+
+  // The first reading is always reported
+  CHECK(reporter.due(100, windowOf(99, 101, 100), 5000));
+  CHECK(reporter.lastValue == 100 && reporter.reported == 1);
+
+  // Inside the deadband and the excursion band: skipped
+  CHECK(!reporter.due(104, windowOf(96, 106, READING_DEADBAND - 1 + 100), 10000));
+  CHECK(reporter.skipped == 1);
+
+  // The window mean moved by the deadband
+  CHECK(reporter.due(105, windowOf(100, 106, 100 + READING_DEADBAND), 15000));
+  CHECK(reporter.lastValue == 105);
+
+  // A brief peak moved by the excursion, mean unchanged
+  CHECK(reporter.due(105, windowOf(104, 105 + READING_EXCURSION, 105), 20000));
+  CHECK(reporter.due(105, windowOf(105 - READING_EXCURSION, 106, 105), 25000));
+
+  // No change at all: reported once the heartbeat is due
+  CHECK(!reporter.due(105, windowOf(105, 105, 105), 25000 + READING_HEARTBEAT - 1));
+  CHECK(reporter.due(105, windowOf(105, 105, 105), 25000 + READING_HEARTBEAT));
+
+  // A deadband of 0 reports every interval
+  ReadingReporterConfig everyInterval = defaultReporterConfig();
+  everyInterval.deadband = 0;
+  ReadingReporter plain(everyInterval);
+  CHECK(plain.due(100, windowOf(100, 100, 100), 5000));
+  CHECK(plain.due(100, windowOf(100, 100, 100), 10000));
+  CHECK(plain.skipped == 0);
+
+  // Window summaries: a reading posted by GasSensing carries the window of
+  // every interval since the previous one, skipped ones included
+  GasFilter filter = makeFilter();
+  GasBaseline baseline = { BASELINE_BLOCK_SAMPLES, BASELINE_WARMUP_BLOCKS, BASELINE_ALPHA_UP, BASELINE_ALPHA_DOWN,
+                           BASELINE_FREEZE_RATIO, 0, 0, 0, 0, 0 };
+  GasDetector detector(defaultDetectorConfig(), 150, 120);
+  ReadingReporter summaries(defaultReporterConfig());
+  GasSensing sensing(filter, baseline, detector, summaries);
+  filter.update(100);
+  sensing.read();
+  sensing.check(READING_INTERVAL + 1);
+  SensorEvent event = {};
+  CHECK(sensing.events.pop(event));
+  CHECK(event.type == EVENT_READING && event.gasValue == 100);
+  CHECK(filter.window.count == 0);
+
+  const float frames[] = { 90, 90, 90, 300, 300 };
+  float sum = 0, low = 1000, high = 0;
+  for (uint8_t i = 0; i < 5; i++) {
+    float value = filter.update(frames[i]);
+    sum += value;
+    if (value < low) low = value;
+    if (value > high) high = value;
+    if (i != 2) continue;
+    sensing.read();
+    sensing.check(2 * READING_INTERVAL + 2); // Inside both bands: skipped
+    CHECK(!sensing.events.pop(event));
+    CHECK(filter.window.count == 3);
+  }
+  sensing.read();
+  sensing.check(3 * READING_INTERVAL + 3); // The peak crossed the excursion band
+  CHECK(sensing.events.pop(event));
+  CHECK(event.type == EVENT_READING);
+  CHECK(event.gasMin == low && event.gasMax == high);
+  CHECK(fabsf(event.gasMean - sum / 5) < 0.001f);
+  CHECK(filter.window.count == 0);
+}
+
+// ==================== UPLOAD QUEUE ====================
+static uint32_t fakeNow = 0;
+static uint32_t fakeClock() { return fakeNow; }
+
+// Backend that answers with fixed results and records what it was sent
+struct FakeBackend {
+  SendResult alertResult;
+  SendResult readingResult;
+  char sent[16][ALERT_TYPE_SIZE]; // Alert types, in send order
+  uint8_t alertCalls;
+  uint16_t batchSizes[8];
+  uint32_t firstTimestamps[8];
+  uint8_t batchCalls;
+};
+
+static SendResult fakeSendAlert(const PendingAlert& alert, void* context) {
+  FakeBackend& fake = *static_cast<FakeBackend*>(context);
+  if (fake.alertCalls < 16) snprintf(fake.sent[fake.alertCalls], ALERT_TYPE_SIZE, "%s", alert.alertType);
+  fake.alertCalls++;
+  return fake.alertResult;
+}
+
+static SendResult fakeSendReadings(const BufferedReading* rows, uint16_t count, void* context) {
+  FakeBackend& fake = *static_cast<FakeBackend*>(context);
+  if (fake.batchCalls < 8) {
+    fake.batchSizes[fake.batchCalls] = count;
+    fake.firstTimestamps[fake.batchCalls] = rows[0].timestamp;
+  }
+  fake.batchCalls++;
+  return fake.readingResult;
+}
+
+static SensorEvent alertEvent(GasTransition transition, uint32_t timestamp) {
+  SensorEvent event = {};
+  event.type = EVENT_ALERT;
+  event.transition = transition;
+  event.timestamp = timestamp;
+  event.gasValue = 200;
+  return event;
+}
+
+static SensorEvent readingEvent(uint32_t timestamp) {
+  SensorEvent event = {};
+  event.type = EVENT_READING;
+  event.timestamp = timestamp;
+  event.gasValue = event.gasMin = event.gasMax = event.gasMean = 100;
+  return event;
+}
+
+static void testUploadQueue() {
+  static FakeBackend fake;
+  memset(&fake, 0, sizeof(fake));
+  UploadBackend backend = { &fake, fakeClock, fakeSendAlert, fakeSendReadings, nullptr, nullptr };
+  static SensorEventQueue events;
+  fakeNow = 1000;
+
+  // Emergencies go to their own lane and are sent before older alerts
+  UploadQueue* uploads = new UploadQueue(backend);
+  events.push(alertEvent(TRANSITION_WARNING, 900));
+  events.push(alertEvent(TRANSITION_EMERGENCY, 950));
+  uploads->drain(events);
+  CHECK(uploads->urgentAlerts.count == 1 && uploads->pendingAlerts.count == 1);
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 1);
+  CHECK_STR(fake.sent[0], "gas_emergency");
+  CHECK(uploads->urgentAlerts.count == 0 && uploads->alertLatency.count == 1 && uploads->alertLatency.max == 50);
+
+  // Nothing else is sent while failed requests are waited out
+  uploads->uploadPass(true);
+  CHECK(fake.alertCalls == 1);
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 2);
+  CHECK_STR(fake.sent[1], "gas_warning");
+  CHECK(uploads->pendingAlerts.count == 0);
+
+  // A transient failure keeps the emergency queued and backs off, doubling
+  fake.alertResult = SEND_RETRY;
+  events.push(alertEvent(TRANSITION_EMERGENCY, fakeNow));
+  events.push(alertEvent(TRANSITION_NORMAL, fakeNow));
+  uploads->drain(events);
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 3 && uploads->urgentAlerts.count == 1 && uploads->urgentRetries == 1);
+  fakeNow += URGENT_RETRY_MIN - 1;
+  uploads->uploadPass(false); // Still waiting; the pending alert waits too
+  CHECK(fake.alertCalls == 3);
+  fakeNow += 1;
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 4 && uploads->urgentRetries == 2);
+  CHECK(uploads->urgentBackoff.delay == 2 * URGENT_RETRY_MIN);
+  fakeNow += 2 * URGENT_RETRY_MIN;
+  fake.alertResult = SEND_OK;
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 5 && uploads->urgentAlerts.count == 0 && uploads->urgentBackoff.delay == 0);
+  CHECK(uploads->pendingAlerts.count == 1);
+
+  // A rejected alert is dropped and counted, never retried
+  fake.alertResult = SEND_REJECTED;
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 6 && uploads->pendingAlerts.count == 0 && uploads->alertsRejected == 1);
+  events.push(alertEvent(TRANSITION_EMERGENCY, fakeNow));
+  uploads->drain(events);
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 7 && uploads->urgentAlerts.count == 0 && uploads->alertsRejected == 2);
+  CHECK(uploads->urgentRetries == 2);
+
+  // A full lane drops its oldest alert
+  for (uint32_t i = 0; i < PENDING_ALERT_CAPACITY + 1; i++) {
+    uploads->queueAlert(uploads->pendingAlerts, "gas_warning", "", "{}", i);
+  }
+  CHECK(uploads->pendingAlerts.count == PENDING_ALERT_CAPACITY && uploads->alertsDropped == 1);
+  CHECK(uploads->pendingAlerts.front().timestamp == 1);
+  delete uploads;
+
+  // Readings: a batch is due once full, or once the oldest is old enough
+  memset(&fake, 0, sizeof(fake));
+  uploads = new UploadQueue(backend);
+  fakeNow = 100000;
+  for (uint16_t i = 0; i < READING_BATCH_SIZE - 1; i++) uploads->queueReading(readingEvent(fakeNow));
+  CHECK(!uploads->readingsDue());
+  fakeNow += READING_BATCH_MAX_AGE;
+  CHECK(uploads->readingsDue());
+  fakeNow -= READING_BATCH_MAX_AGE;
+  uploads->queueReading(readingEvent(fakeNow));
+  CHECK(uploads->readingsDue());
+  uploads->uploadPass(false);
+  CHECK(fake.batchCalls == 1 && fake.batchSizes[0] == READING_BATCH_SIZE);
+  CHECK(uploads->readingCount == 0 && uploads->readingBatchesSent == 1);
+
+  // The ring drops its oldest reading when full
+  for (uint32_t i = 0; i < READING_BUFFER_CAPACITY + 2; i++) uploads->queueReading(readingEvent(i));
+  CHECK(uploads->readingCount == READING_BUFFER_CAPACITY && uploads->readingsDropped == 2);
+  BufferedReading oldest;
+  CHECK(uploads->peekReadings(&oldest, 1) == 1 && oldest.timestamp == 2);
+
+  // A failed flush keeps the rows and waits READING_FLUSH_RETRY
+  fake.readingResult = SEND_RETRY;
+  fakeNow = 200000;
+  uploads->uploadPass(false);
+  CHECK(fake.batchCalls == 2 && fake.batchSizes[1] == READING_UPLOAD_MAX && fake.firstTimestamps[1] == 2);
+  CHECK(uploads->readingCount == READING_BUFFER_CAPACITY);
+  fakeNow += READING_FLUSH_RETRY - 1;
+  CHECK(!uploads->readingsDue());
+  fakeNow += 1;
+  CHECK(uploads->readingsDue());
+
+  // A rejected batch is dropped and counted; the rest goes next
+  fake.readingResult = SEND_REJECTED;
+  uploads->uploadPass(false);
+  CHECK(fake.batchCalls == 3 && uploads->readingsRejected == READING_UPLOAD_MAX);
+  CHECK(uploads->readingCount == READING_BUFFER_CAPACITY - READING_UPLOAD_MAX);
+  fake.readingResult = SEND_OK;
+  uploads->flushRequested = true;
+  uploads->uploadPass(false);
+  CHECK(fake.batchCalls == 4 && fake.firstTimestamps[3] == 2 + READING_UPLOAD_MAX);
+  CHECK(uploads->readingCount == 0 && !uploads->flushRequested);
+
+  // Queued alerts go before readings
+  for (uint16_t i = 0; i < READING_BATCH_SIZE; i++) uploads->queueReading(readingEvent(fakeNow));
+  uploads->queueAlert(uploads->pendingAlerts, "gas_warning", "", "{}", fakeNow);
+  uploads->uploadPass(false);
+  CHECK(fake.alertCalls == 1 && fake.batchCalls == 4);
+  uploads->uploadPass(false);
+  CHECK(fake.batchCalls == 5);
+  delete uploads;
+}
+
+// ==================== MAIN ====================
+struct Suite {
+  const char* name;
+  void (*run)();
+};
+
+int main(int argc, char** argv) {
+  const Suite suites[] = {
+    { "json_reader", testJsonReader },
+    { "json_writer", testJsonWriter },
+    { "reading_codec", testReadingCodec },
+    { "device_config", testDeviceConfig },
+    { "gas_filter", testGasFilter },
+    { "gas_baseline", testGasBaseline },
+    { "gas_detector", testGasDetector },
+    { "reading_reporter", testReadingReporter },
+    { "upload_queue", testUploadQueue },
+  };
+  const char* only = argc > 1 ? argv[1] : nullptr;
+  bool ran = false;
+  for (const Suite& suite : suites) {
+    if (only != nullptr && strcmp(only, suite.name) != 0) continue;
+    int before = failures;
+    suite.run();
+    printf("%s %s\n", failures == before ? "✅" : "❌", suite.name);
+    ran = true;
+  }
+  if (!ran) {
+    fprintf(stderr, "❌ Unknown suite '%s'\n", only);
+    return 2;
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+// Micro-benchmarks for the portable detector core. Each case reports the
+// mean cost per operation and the heap allocations it made; the firmware
+// hot paths must not allocate, so any allocation fails the run.
+//
+//   ./gas_bench [iterations]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "broadcast_ring.h"
+#include "firmware_constants.h"
+#include "gas_detector.h"
+#include "gas_filter.h"
+#include "json_reader.h"
+#include "json_writer.h"
+#include "metrics.h"
+#include "mock_hal.h"
+#include "payloads.h"
+#include "reading_codec.h"
+#include "spsc_queue.h"
+
+#define MQ5_PIN 34
+
+struct BenchResult {
+  const char* name;
+  double nsPerOp;
+  uint64_t allocations;
+};
+
+static float sink = 0; // Keeps the optimizer from dropping the work
+
+static void countChunk(const char* text, size_t length, void* context) {
+  *static_cast<size_t*>(context) += length;
+  sink += text[length - 1];
+}
+
+// Clean air around 90 with a leak ramping in every 10 s of simulated time
+static uint16_t syntheticTrace(uint32_t now, void* context) {
+  uint32_t* seed = static_cast<uint32_t*>(context);
+  *seed = *seed * 1664525u + 1013904223u;
+  int noise = (int)(*seed >> 28) - 8;
+  uint32_t phase = now % 10000;
+  int leak = phase > 6000 ? (int)(phase - 6000) / 20 : 0;
+  return (uint16_t)(90 + leak + noise);
+}
+
+template <typename Fn>
+static BenchResult run(const char* name, uint32_t iterations, Fn fn) {
+  resetAllocationStats();
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    fn(i);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+  return { name, ns / iterations, allocationStats().count };
+}
+
+int main(int argc, char** argv) {
+  uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 1000000;
+  if (iterations == 0) iterations = 1;
+
+  BenchResult results[8];
+  uint8_t resultCount = 0;
+
+  // Per-sample path of the sensing task: ADC frame -> filter -> detector
+  uint32_t seed = 1;
+  setAdcSource(syntheticTrace, &seed);
+  GasFilter filter = { GAS_EMA_ALPHA, { 0, 0, 0 }, 0, 0, 0, { 0, 0, 0, 0 } };
+  GasDetector detector(defaultDetectorConfig(), 150, 100);
+  uint32_t transitions = 0;
+  results[resultCount++] = run("sample (filter + detector)", iterations, [&](uint32_t) {
+    advanceMillis(1);
+    float value = filter.update(analogRead(MQ5_PIN));
+    if (detector.update(value, millis()) != TRANSITION_NONE) transitions++;
+    sink += value;
+  });
+
+  // One full reading batch as uploaded to device_readings
+  static char uploadBuffer[UPLOAD_BUFFER_SIZE];
+  StoredReading batch[READING_BATCH_SIZE];
+  for (uint8_t i = 0; i < READING_BATCH_SIZE; i++) {
+    batch[i] = { 1762257600u + i * 5u, 95.5f + i, 90.1f, 101.7f, 95.2f };
+  }
+  size_t batchBytes = 0;
+  results[resultCount++] = run("reading batch payload", iterations / 100 + 1, [&](uint32_t) {
+    JsonWriter payload(uploadBuffer, sizeof(uploadBuffer));
+    payload.beginArray();
+    for (uint8_t i = 0; i < READING_BATCH_SIZE; i++) {
+      buildReadingJson(payload, "ESP32-A1B2C3D4E5F6", "0b7e2a34-5f1c-4c55-9c1e-6a0b8f7d2e11", batch[i], true, true);
+    }
+    payload.endArray();
+    batchBytes = payload.size();
+  });
+
+  // The same batch in the binary encoding for the ingest-readings function
+  size_t binaryBytes = 0;
+  results[resultCount++] = run("reading batch binary", iterations / 100 + 1, [&](uint32_t) {
+    BinaryWriter payload((uint8_t*)uploadBuffer, sizeof(uploadBuffer));
+    ReadingBatchEncoder encoder(payload);
+    encoder.begin("ESP32-A1B2C3D4E5F6", "0b7e2a34-5f1c-4c55-9c1e-6a0b8f7d2e11", READING_BATCH_SIZE, true, true);
+    for (uint8_t i = 0; i < READING_BATCH_SIZE; i++) {
+      encoder.add(batch[i]);
+    }
+    binaryBytes = payload.size();
+  });
+
+  // Alert message and payload for an emergency transition
+  results[resultCount++] = run("alert payload", iterations / 10 + 1, [&](uint32_t i) {
+    char message[128];
+    char sensorData[192];
+    char buf[512];
+    JsonWriter data(sensorData, sizeof(sensorData));
+    const char* alertType = buildGasAlert(TRANSITION_EMERGENCY, 180.0f + (i & 7), 4.4f, 150.0f,
+                                          message, sizeof(message), data);
+    JsonWriter payload(buf, sizeof(buf));
+    buildAlertPayload(payload, "ESP32-A1B2C3D4E5F6", "", alertType, message, sensorData, "");
+    sink += payload.size();
+  });
+
+  // PostgREST error body, as parsed after a failed request
+  static const char errorBody[] =
+    "{\"code\":\"23503\",\"details\":\"Key (device_id)=(ESP32-A1B2C3D4E5F6) is not present in table \\\"devices\\\".\","
+    "\"hint\":null,\"message\":\"insert or update on table \\\"device_readings\\\" violates foreign key constraint\"}";
+  results[resultCount++] = run("parse error body", iterations / 10 + 1, [&](uint32_t) {
+    char code[16];
+    char message[128];
+    JsonField fields[] = {
+      { "code", code, sizeof(code), false },
+      { "message", message, sizeof(message), false },
+    };
+    parseJsonFields(errorBody, sizeof(errorBody) - 1, fields, 2);
+    sink += fields[1].found;
+  });
+
+  // Sensing -> network handoff
+  static SpscQueue<StoredReading, 64> queue;
+  results[resultCount++] = run("spsc push + pop", iterations, [&](uint32_t i) {
+    StoredReading reading = { i, 1, 2, 3, 4 };
+    queue.push(reading);
+    queue.pop(reading);
+    sink += reading.gasLevel;
+  });
+
+  // Local stream: one reading frame published and sent to 4 subscribers
+  static BroadcastRing<16, 192> ring;
+  uint32_t cursors[4] = { 0, 0, 0, 0 };
+  results[resultCount++] = run("stream frame x4 subscribers", iterations / 10 + 1, [&](uint32_t i) {
+    char* frame = ring.slot();
+    size_t prefix = snprintf(frame, 192, "id: %lu\nevent: reading\ndata: ", (unsigned long)ring.next);
+    JsonWriter json(frame + prefix, 192 - prefix - 2);
+    json.beginObject();
+    json.field("t", (unsigned long)i);
+    json.field("gas_value", 95.5 + (i & 7), 1);
+    json.field("state", GasDetector::stateName(STATE_NORMAL));
+    json.endObject();
+    size_t length = prefix + json.size();
+    frame[length++] = '\n';
+    frame[length++] = '\n';
+    ring.publish(length);
+    for (uint32_t& cursor : cursors) {
+      ring.catchUp(cursor);
+      while (cursor < ring.next) {
+        size_t n;
+        sink += ring.frame(cursor, n)[n - 1] + n;
+        cursor++;
+      }
+    }
+  });
+
+  // /metrics: one labelled request-latency histogram, streamed in chunks
+  static const uint32_t bounds[] = { 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+  Histogram<8> requestTimes = { bounds, { 0 }, 0, 0, 0 };
+  for (uint32_t i = 0; i < 1000; i++) requestTimes.add((i * 37) % 3000);
+  size_t metricsBytes = 0;
+  results[resultCount++] = run("metrics histogram", iterations / 100 + 1, [&](uint32_t) {
+    char buf[768];
+    PromWriter prom(buf, sizeof(buf), countChunk, &metricsBytes);
+    prom.family("gasguardian_request_duration_milliseconds", "histogram", "Supabase requests");
+    prom.histogram("gasguardian_request_duration_milliseconds", "endpoint=\"device_readings\",code=\"2xx\"", requestTimes);
+    prom.finish();
+  });
+
+  bool allocated = false;
+  printf("%-28s %12s %12s\n", "benchmark", "ns/op", "allocations");
+  for (uint8_t i = 0; i < resultCount; i++) {
+    printf("%-28s %12.1f %12llu\n", results[i].name, results[i].nsPerOp, (unsigned long long)results[i].allocations);
+    if (results[i].allocations > 0) allocated = true;
+  }
+  printf("\nsamples: %u, transitions: %u, batch size: %zu bytes JSON, %zu bytes binary (checksum %.1f)\n",
+         iterations, transitions, batchBytes, binaryBytes, sink);
+
+  if (allocated) {
+    printf("❌ Hot path allocated on the heap\n");
+    return 1;
+  }
+  return 0;
+}
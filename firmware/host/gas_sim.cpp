@@ -0,0 +1,500 @@
+// Sensor-trace simulator. Replays a synthetic or recorded MQ5 trace through
+// the firmware's own sensing and upload code (gas_sensing.h, upload_queue.h)
+// on the firmware's task periods and settings, with the requests going to
+// an in-process Supabase stand-in. Reports detection latency, false alarms
+// and backend traffic per scenario.
+//
+//   ./gas_sim                         all built-in scenarios, 1 simulated hour each
+//   ./gas_sim --scenario step         one scenario
+//   ./gas_sim --trace run.csv         recorded trace: "<ms>,<adc>" per line
+//             [--leak-start s] [--leak-end s]
+//   options:  --hours h  --seed n  --http-latency ms  --http-errors rate  --baseline f  --no-calibrate
+//
+// --baseline starts from a persisted clean-air baseline (a warm boot);
+// --no-calibrate keeps the default thresholds for the whole run;
+// --http-errors answers that share of requests with a 503.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "firmware_constants.h"
+#include "gas_baseline.h"
+#include "gas_detector.h"
+#include "gas_filter.h"
+#include "gas_sensing.h"
+#include "json_writer.h"
+#include "mock_hal.h"
+#include "payloads.h"
+#include "reading_codec.h"
+#include "reading_reporter.h"
+#include "upload_queue.h"
+
+#define MQ5_SENSOR_PIN 34
+#define SIM_DEVICE_ID "ESP32-SIM000000001"
+#define SIM_USER_ID "00000000-0000-4000-8000-000000000001"
+
+// ==================== TRACES ====================
+struct Rng {
+  uint32_t state;
+
+  float uniform() {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / 16777216.0f;
+  }
+
+  // Roughly normal, mean 0, standard deviation 1
+  float gaussian() {
+    return (uniform() + uniform() + uniform() + uniform() - 2.0f) * 1.732f;
+  }
+};
+
+struct Trace;
+typedef float (*TraceLevel)(const Trace& trace, uint32_t t, Rng& rng);
+
+struct Trace {
+  const char* name;
+  const char* description;
+  uint32_t leakStart; // ms; leakStart == leakEnd means no leak
+  uint32_t leakEnd;
+  TraceLevel level;
+  std::vector<uint32_t> times; // Recorded traces only
+  std::vector<float> values;
+};
+
+#define CLEAN_AIR 90.0f
+
+static float cleanLevel(const Trace&, uint32_t, Rng& rng) {
+  return CLEAN_AIR + rng.gaussian() * 3.0f;
+}
+
+static float stepLevel(const Trace& trace, uint32_t t, Rng& rng) {
+  float leak = (t >= trace.leakStart && t < trace.leakEnd) ? 310.0f : 0.0f;
+  return CLEAN_AIR + leak + rng.gaussian() * 3.0f;
+}
+
+// Leak builds up over 20 minutes, holds, then is vented at leakEnd
+static float rampLevel(const Trace& trace, uint32_t t, Rng& rng) {
+  float leak = 0;
+  if (t >= trace.leakStart && t < trace.leakEnd) {
+    float progress = (t - trace.leakStart) / 1200000.0f;
+    leak = 160.0f * (progress < 1.0f ? progress : 1.0f);
+  }
+  return CLEAN_AIR + leak + rng.gaussian() * 3.0f;
+}
+
+// Heavy noise with occasional single-frame spikes from supply glitches
+static float noisyLevel(const Trace&, uint32_t, Rng& rng) {
+  float spike = rng.uniform() < 0.002f ? 400.0f : 0.0f;
+  return CLEAN_AIR + rng.gaussian() * 12.0f + spike;
+}
+
+// Clean air hovering just under the calibrated warning level
+static float marginalLevel(const Trace&, uint32_t t, Rng& rng) {
+  float drift = 20.0f * sinf(t / 600000.0f * 6.2832f);
+  return CLEAN_AIR + 15.0f + drift + rng.gaussian() * 5.0f;
+}
+
+// Cold MQ5 heater: the output starts high and settles over a few minutes,
+// with a small real leak once it is warm
+static float warmupLevel(const Trace& trace, uint32_t t, Rng& rng) {
+  float settling = 450.0f * expf(-(float)t / 180000.0f);
+  float leak = (t >= trace.leakStart && t < trace.leakEnd) ? 120.0f : 0.0f;
+  return CLEAN_AIR + settling + leak + rng.gaussian() * 3.0f;
+}
+
+static float recordedLevel(const Trace& trace, uint32_t t, Rng&) {
+  // Sample-and-hold between recorded points
+  size_t lo = 0, hi = trace.times.size();
+  while (hi - lo > 1) {
+    size_t mid = (lo + hi) / 2;
+    if (trace.times[mid] <= t) lo = mid; else hi = mid;
+  }
+  return trace.values[lo];
+}
+
+static bool loadTrace(const char* path, Trace& trace) {
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "❌ Cannot open %s\n", path);
+    return false;
+  }
+  char line[128];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    unsigned long t;
+    float value;
+    if (sscanf(line, "%lu,%f", &t, &value) != 2) continue; // Header or junk
+    if (!trace.times.empty() && t < trace.times.back()) {
+      fprintf(stderr, "❌ %s: timestamps must not go backwards (%lu)\n", path, t);
+      fclose(file);
+      return false;
+    }
+    trace.times.push_back((uint32_t)t);
+    trace.values.push_back(value);
+  }
+  fclose(file);
+  if (trace.times.empty()) {
+    fprintf(stderr, "❌ %s: no samples\n", path);
+    return false;
+  }
+  trace.name = "recorded";
+  trace.description = path;
+  trace.level = recordedLevel;
+  return true;
+}
+
+// ==================== SIMULATION ====================
+struct SimOptions {
+  uint32_t duration;
+  uint32_t seed;
+  uint32_t httpLatency; // ms the network task is blocked per request
+  float httpErrors;     // Share of requests the backend answers with a 503
+  bool calibrate;
+  float storedBaseline; // Warm boot from this baseline, 0 for a cold boot
+  float deadband;       // Report-on-change deadband, 0 for a reading every interval
+  bool summaries;
+  bool binary;          // Reading batches in the ingest-readings encoding
+};
+
+struct SimStats {
+  float threshold;       // At the end of the run
+  float warningLevel;
+  int64_t firstWarning;  // ms after leak start, -1 if never
+  int64_t firstAlarm;
+  int64_t allClear;      // ms after leak end
+  uint32_t falseAlarms;
+  uint32_t alertsSent;   // Gas alerts the backend acknowledged
+  uint32_t suppressed;   // Transitions held back by the cooldown
+  uint32_t debounced;    // Transitions the dwell times filtered out
+  uint32_t alertsDropped;
+  uint32_t alertsRejected;
+  uint32_t urgentRetries;
+  uint32_t readingsDropped;
+  uint32_t eventsDropped;
+  uint32_t maxAlertLatency;
+  uint32_t maxEmergencyLatency;
+  uint32_t readingBatches;
+  HttpSinkStats http;
+};
+
+// ADC source for the mock HAL: the trace level at the current simulated time
+struct TraceSource {
+  const Trace* trace;
+  Rng rng;
+};
+
+static uint16_t readTrace(uint32_t now, void* context) {
+  TraceSource* source = static_cast<TraceSource*>(context);
+  float value = source->trace->level(*source->trace, now, source->rng);
+  if (value < 0) value = 0;
+  if (value > 4095) value = 4095;
+  return (uint16_t)value;
+}
+
+// Network side of the firmware: the upload queue's requests go to the
+// Supabase stand-in, and each one blocks the network task for httpLatency
+struct SimNetwork {
+  const SimOptions* options;
+  SimStats* stats;
+  RetryBackoff backoff; // supabaseBackoff
+  uint32_t busyUntil;
+  char uploadBuffer[UPLOAD_BUFFER_SIZE];
+};
+
+static int simPost(SimNetwork& network, const char* endpoint, const char* body, size_t length) {
+  int status = httpPost(endpoint, body, length);
+  network.busyUntil = millis() + network.options->httpLatency;
+  // As sendRestRequestLocked(): an error answer slows the next request down
+  if (status >= 400) {
+    network.backoff.fail(millis());
+  } else {
+    network.backoff.succeed();
+  }
+  return status;
+}
+
+static SendResult simSendAlert(const PendingAlert& alert, void* context) {
+  SimNetwork& network = *static_cast<SimNetwork*>(context);
+  char buf[576];
+  JsonWriter payload(buf, sizeof(buf));
+  buildAlertPayload(payload, SIM_DEVICE_ID, SIM_USER_ID, alert.alertType, alert.message, alert.sensorData, "");
+  SendResult result = classifyResponse(true, simPost(network, "/rest/v1/alerts", payload.c_str(), payload.size()), 201);
+  if (result == SEND_OK) {
+    SimStats& stats = *network.stats;
+    uint32_t latency = millis() - alert.timestamp;
+    stats.alertsSent++;
+    if (latency > stats.maxAlertLatency) stats.maxAlertLatency = latency;
+    if (strcmp(alert.alertType, "gas_emergency") == 0 && latency > stats.maxEmergencyLatency) {
+      stats.maxEmergencyLatency = latency;
+    }
+  }
+  return result;
+}
+
+// The simulated clock is never synced, so rows carry no created_at
+static SendResult simSendReadings(const BufferedReading* readings, uint16_t count, void* context) {
+  SimNetwork& network = *static_cast<SimNetwork*>(context);
+  const SimOptions& options = *network.options;
+  int status;
+  if (options.binary) {
+    BinaryWriter payload((uint8_t*)network.uploadBuffer, sizeof(network.uploadBuffer));
+    ReadingBatchEncoder encoder(payload);
+    encoder.begin(SIM_DEVICE_ID, SIM_USER_ID, count, false, options.summaries);
+    for (uint16_t i = 0; i < count; i++) {
+      encoder.add({ 0, readings[i].gasLevel, readings[i].gasMin, readings[i].gasMax, readings[i].gasMean });
+    }
+    status = simPost(network, "/functions/v1/ingest-readings", (const char*)payload.data(), payload.size());
+  } else {
+    JsonWriter payload(network.uploadBuffer, sizeof(network.uploadBuffer));
+    payload.beginArray();
+    for (uint16_t i = 0; i < count; i++) {
+      StoredReading row = { 0, readings[i].gasLevel, readings[i].gasMin, readings[i].gasMax, readings[i].gasMean };
+      buildReadingJson(payload, SIM_DEVICE_ID, SIM_USER_ID, row, false, options.summaries);
+    }
+    payload.endArray();
+    status = simPost(network, "/rest/v1/device_readings", payload.c_str(), payload.size());
+  }
+  return classifyResponse(true, status, 201);
+}
+
+static SimStats simulate(const Trace& trace, const SimOptions& options) {
+  SimStats stats;
+  memset(&stats, 0, sizeof(stats));
+  stats.firstWarning = stats.firstAlarm = stats.allClear = -1;
+
+  resetMillis();
+  resetHttpSink();
+  setHttpFaults(options.httpErrors, 503);
+  TraceSource source = { &trace, { options.seed } };
+  setAdcSource(readTrace, &source);
+
+  // Sensing task state, as set up by the sketch
+  GasFilter filter = { GAS_EMA_ALPHA, { 0, 0, 0 }, 0, 0, 0, { 0, 0, 0, 0 } };
+  GasBaseline baseline = { BASELINE_BLOCK_SAMPLES, BASELINE_WARMUP_BLOCKS, BASELINE_ALPHA_UP, BASELINE_ALPHA_DOWN,
+                           BASELINE_FREEZE_RATIO, 0, 0, 0, 0, 0 };
+  GasDetector detector(defaultDetectorConfig(), 150, 100);
+  ReadingReporterConfig reporterConfig = defaultReporterConfig();
+  reporterConfig.deadband = options.deadband;
+  reporterConfig.summaries = options.summaries;
+  ReadingReporter reporter(reporterConfig);
+  GasSensing sensing(filter, baseline, detector, reporter);
+  if (options.calibrate && options.storedBaseline > 0) {
+    baseline.restore(options.storedBaseline);
+    detector.calibrate(options.storedBaseline);
+  }
+
+  // Network task state
+  SimNetwork network;
+  network.options = &options;
+  network.stats = &stats;
+  network.backoff = { SUPABASE_BACKOFF_MIN, SUPABASE_BACKOFF_MAX, 0, 0 };
+  network.busyUntil = 0;
+  UploadBackend backend = { &network, millis, simSendAlert, simSendReadings, nullptr, nullptr };
+  UploadQueue uploads(backend);
+  bool registered = false;
+  bool announced = false;
+  uint32_t bootRetryAt = 0;
+
+  bool leakCleared = false;
+  bool hasLeak = trace.leakEnd > trace.leakStart;
+
+  for (uint32_t now = millis(); now < options.duration; advanceMillis(ADC_FRAME_PERIOD), now = millis()) {
+    filter.update(analogRead(MQ5_SENSOR_PIN));
+
+    // Sensing task: sampleTask()
+    if (now % SAMPLE_PERIOD == 0) {
+      sensing.read();
+      if (options.calibrate) sensing.updateBaseline();
+      GasTransition transition = sensing.check(now);
+      if (transition != TRANSITION_NONE) {
+        bool inLeak = hasLeak && now >= trace.leakStart && !leakCleared;
+        if (transition == TRANSITION_NORMAL) {
+          if (hasLeak && now >= trace.leakEnd && !leakCleared) {
+            stats.allClear = now - trace.leakEnd;
+            leakCleared = true;
+          }
+        } else if (!inLeak) {
+          stats.falseAlarms++;
+        } else {
+          if (stats.firstWarning < 0) stats.firstWarning = now - trace.leakStart;
+          if (transition == TRANSITION_EMERGENCY && stats.firstAlarm < 0) stats.firstAlarm = now - trace.leakStart;
+        }
+      }
+    }
+
+    // Network task; nothing runs while a request is in flight
+    if (now < network.busyUntil) continue;
+
+    // drainSensorEvents(): emergencies don't wait for the next upload pass
+    if (now % EVENT_DRAIN_PERIOD == 0) {
+      uploads.drain(sensing.events);
+      if (uploads.urgentAlerts.count > 0 && registered) uploads.sendUrgentAlerts();
+    }
+    if (now % UPLOAD_PERIOD != 0 || now < network.busyUntil) continue;
+
+    // bootTask(): register the devices row, then announce the device once
+    // queued emergencies are through; one request per pass
+    if (!announced && (int32_t)(now - bootRetryAt) >= 0) {
+      char buf[512];
+      JsonWriter payload(buf, sizeof(buf));
+      if (!registered) {
+        buildDeviceRegistration(payload, SIM_DEVICE_ID);
+        int status = simPost(network, "/rest/v1/devices", payload.c_str(), payload.size());
+        registered = status == 201 || status == 409; // 409: the row already exists
+        if (!registered) bootRetryAt = now + BOOT_RETRY_DELAY;
+      } else if (uploads.urgentAlerts.count == 0) {
+        buildAlertPayload(payload, SIM_DEVICE_ID, SIM_USER_ID, "system", "Gas detector started", "{}", "");
+        SendResult result = classifyResponse(true, simPost(network, "/rest/v1/alerts", payload.c_str(), payload.size()), 201);
+        if (result == SEND_RETRY) {
+          bootRetryAt = now + BOOT_RETRY_DELAY;
+        } else {
+          if (result == SEND_REJECTED) uploads.alertsRejected++;
+          announced = true;
+        }
+      }
+    }
+
+    // uploadTask(): rows reference the devices row, so nothing is sent before it exists
+    if (registered && now >= network.busyUntil) uploads.uploadPass(network.backoff.waiting(now));
+  }
+
+  stats.threshold = detector.threshold;
+  stats.debounced = detector.suppressed;
+  stats.suppressed = detector.held;
+  stats.warningLevel = detector.warningLevel;
+  stats.alertsDropped = uploads.alertsDropped;
+  stats.alertsRejected = uploads.alertsRejected;
+  stats.urgentRetries = uploads.urgentRetries;
+  stats.readingsDropped = uploads.readingsDropped;
+  stats.eventsDropped = sensing.eventsDropped;
+  stats.readingBatches = uploads.readingBatchesSent;
+  stats.http = httpSinkStats();
+  return stats;
+}
+
+// ==================== REPORT ====================
+static void formatSeconds(int64_t ms, char* buf, size_t size) {
+  if (ms < 0) snprintf(buf, size, "-");
+  else snprintf(buf, size, "%.2f", ms / 1000.0);
+}
+
+static void printHeader() {
+  printf("%-10s %8s %8s %8s %8s %7s %6s %6s %6s %7s %8s %8s %8s %9s %9s\n",
+         "scenario", "thresh", "warn s", "alarm s", "clear s", "alerts", "supp", "dwell", "false",
+         "req/h", "kB/h", "batches", "rows/h", "max lat s", "emerg s");
+}
+
+static void printStats(const Trace& trace, const SimStats& stats, uint32_t duration) {
+  char warning[16], alarm[16], clear[16], latency[16], emergency[16];
+  formatSeconds(stats.firstWarning, warning, sizeof(warning));
+  formatSeconds(stats.firstAlarm, alarm, sizeof(alarm));
+  formatSeconds(stats.allClear, clear, sizeof(clear));
+  formatSeconds(stats.alertsSent ? (int64_t)stats.maxAlertLatency : -1, latency, sizeof(latency));
+  formatSeconds(stats.firstAlarm >= 0 ? (int64_t)stats.maxEmergencyLatency : -1, emergency, sizeof(emergency));
+  double hours = duration / 3600000.0;
+  printf("%-10s %8.1f %8s %8s %8s %7u %6u %6u %6u %7.1f %8.1f %8u %8.1f %9s %9s\n",
+         trace.name, stats.threshold, warning, alarm, clear, stats.alertsSent, stats.suppressed,
+         stats.debounced, stats.falseAlarms, stats.http.requests / hours, stats.http.bytes / 1024.0 / hours,
+         stats.readingBatches, stats.http.readings / hours, latency, emergency);
+  if (stats.alertsDropped > 0 || stats.readingsDropped > 0 || stats.eventsDropped > 0) {
+    printf("  ⚠️ dropped: %u alerts (lane full), %u readings (buffer full), %u events (queue full)\n",
+           stats.alertsDropped, stats.readingsDropped, stats.eventsDropped);
+  }
+  if (stats.http.failures > 0) {
+    printf("  ⚠️ %u failed requests, %u emergency retries, %u alerts rejected\n",
+           stats.http.failures, stats.urgentRetries, stats.alertsRejected);
+  }
+}
+
+int main(int argc, char** argv) {
+  SimOptions options = { 3600000, 1, 0, 0, true, 0, READING_DEADBAND, true, false };
+  const char* scenario = "all";
+  const char* tracePath = nullptr;
+  double leakStart = -1, leakEnd = -1;
+  bool durationSet = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (strcmp(arg, "--no-calibrate") == 0) {
+      options.calibrate = false;
+    } else if (value && strcmp(arg, "--scenario") == 0) {
+      scenario = value; i++;
+    } else if (value && strcmp(arg, "--trace") == 0) {
+      tracePath = value; i++;
+    } else if (value && strcmp(arg, "--hours") == 0) {
+      options.duration = (uint32_t)(atof(value) * 3600000.0); durationSet = true; i++;
+    } else if (value && strcmp(arg, "--seed") == 0) {
+      options.seed = (uint32_t)strtoul(value, nullptr, 10); i++;
+    } else if (value && strcmp(arg, "--http-latency") == 0) {
+      options.httpLatency = (uint32_t)strtoul(value, nullptr, 10); i++;
+    } else if (value && strcmp(arg, "--http-errors") == 0) {
+      options.httpErrors = (float)atof(value); i++;
+    } else if (value && strcmp(arg, "--baseline") == 0) {
+      options.storedBaseline = (float)atof(value); i++;
+    } else if (value && strcmp(arg, "--deadband") == 0) {
+      options.deadband = (float)atof(value); i++;
+    } else if (strcmp(arg, "--no-summaries") == 0) {
+      options.summaries = false;
+    } else if (strcmp(arg, "--binary") == 0) {
+      options.binary = true;
+    } else if (value && strcmp(arg, "--leak-start") == 0) {
+      leakStart = atof(value); i++;
+    } else if (value && strcmp(arg, "--leak-end") == 0) {
+      leakEnd = atof(value); i++;
+    } else {
+      fprintf(stderr, "usage: %s [--scenario name|all] [--trace file.csv [--leak-start s] [--leak-end s]]\n"
+                      "          [--hours h] [--seed n] [--http-latency ms] [--http-errors rate] [--baseline f] [--no-calibrate]\n"
+                      "          [--deadband counts] [--no-summaries] [--binary]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (options.duration < 60000) options.duration = 60000;
+
+  std::vector<Trace> traces;
+  if (tracePath) {
+    Trace trace = {};
+    if (!loadTrace(tracePath, trace)) return 1;
+    if (leakStart >= 0 && leakEnd > leakStart) {
+      trace.leakStart = (uint32_t)(leakStart * 1000);
+      trace.leakEnd = (uint32_t)(leakEnd * 1000);
+    }
+    // Run a minute past the last sample so the all-clear can still happen
+    if (!durationSet) options.duration = trace.times.back() + 60000;
+    traces.push_back(trace);
+  } else {
+    const Trace builtIn[] = {
+      { "clean", "clean air, sensor noise only", 0, 0, cleanLevel, {}, {} },
+      { "step", "sudden leak at 10 min, vented at 15 min", 600000, 900000, stepLevel, {}, {} },
+      { "ramp", "leak building over 20 min from 10 min, vented at 40 min", 600000, 2400000, rampLevel, {}, {} },
+      { "noisy", "clean air, heavy noise and supply glitches", 0, 0, noisyLevel, {}, {} },
+      { "marginal", "clean air drifting near the warning level", 0, 0, marginalLevel, {}, {} },
+      { "warmup", "cold sensor settling, small leak at 30 min", 1800000, 2100000, warmupLevel, {}, {} },
+    };
+    for (const Trace& trace : builtIn) {
+      if (strcmp(scenario, "all") == 0 || strcmp(scenario, trace.name) == 0) traces.push_back(trace);
+    }
+    if (traces.empty()) {
+      fprintf(stderr, "❌ Unknown scenario '%s'\n", scenario);
+      return 2;
+    }
+  }
+
+  printf("Simulating %.2f h per scenario (seed %u, HTTP latency %u ms, HTTP errors %.0f%%, %s, deadband %.1f%s%s)\n\n",
+         options.duration / 3600000.0, options.seed, options.httpLatency, options.httpErrors * 100,
+         !options.calibrate ? "default thresholds" : options.storedBaseline > 0 ? "warm boot" : "cold boot",
+         options.deadband, options.summaries ? "" : ", no summaries", options.binary ? ", binary" : "");
+  printHeader();
+  for (const Trace& trace : traces) {
+    printStats(trace, simulate(trace, options), options.duration);
+  }
+  printf("\nwarn/alarm: first warning/emergency after leak start; clear: all-clear after leak end\n");
+  printf("supp: repeats of a transition type held back by the %lus alert cooldown\n", ALERT_COOLDOWN / 1000);
+  printf("max lat/emerg: slowest detection-to-acknowledgement time of any alert / of an emergency\n");
+  printf("dwell: level crossings that didn't last their dwell time (%lu/%lu/%lu ms)\n",
+         EMERGENCY_DWELL, WARNING_DWELL, CLEAR_DWELL);
+  return 0;
+}
@@ -0,0 +1,155 @@
+#include "mock_hal.h"
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "json_reader.h"
+#include "reading_codec.h"
+
+// ==================== CLOCK ====================
+static uint32_t simulatedMillis = 0;
+
+uint32_t millis() { return simulatedMillis; }
+void advanceMillis(uint32_t ms) { simulatedMillis += ms; }
+void resetMillis() { simulatedMillis = 0; }
+
+// ==================== ADC ====================
+static AdcSource adcSource = nullptr;
+static void* adcContext = nullptr;
+
+void setAdcSource(AdcSource source, void* context) {
+  adcSource = source;
+  adcContext = context;
+}
+
+uint16_t analogRead(uint8_t) {
+  return adcSource ? adcSource(simulatedMillis, adcContext) : 0;
+}
+
+// ==================== ALLOCATIONS ====================
+static AllocationStats allocations = { 0, 0 };
+
+AllocationStats allocationStats() { return allocations; }
+void resetAllocationStats() { allocations = { 0, 0 }; }
+
+void* operator new(size_t size) {
+  allocations.count++;
+  allocations.bytes += size;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// ==================== SUPABASE STAND-IN ====================
+static HttpSinkStats httpStats = { 0, 0, 0, 0, 0, 0 };
+static std::vector<std::string> registeredDevices;
+static float faultRate = 0;
+static int faultStatus = 503;
+static uint32_t faultState = 1;
+
+static bool deviceKnown(const char* id) {
+  for (const std::string& device : registeredDevices) {
+    if (device == id) return true;
+  }
+  return false;
+}
+
+static bool faultDue() {
+  if (faultRate <= 0) return false;
+  faultState = faultState * 1664525u + 1013904223u;
+  return (faultState >> 8) / 16777216.0f < faultRate;
+}
+
+// POST /rest/v1/devices
+static int insertDevice(const char* payload, size_t length) {
+  char id[64];
+  JsonField fields[] = { { "id", id, sizeof(id), false } };
+  if (!parseJsonFields(payload, length, fields, 1, length) || !fields[0].found) return 400;
+  if (deviceKnown(id)) return 409;
+  registeredDevices.push_back(id);
+  httpStats.devices++;
+  return 201;
+}
+
+// POST /rest/v1/alerts and /rest/v1/device_readings: one object or an
+// array of them, all inserted or none
+static int insertRows(const char* payload, size_t length, bool userIdRequired, uint32_t& inserted) {
+  JsonReader reader = { payload, payload + length };
+  bool array = reader.consume('[');
+  uint32_t rows = 0;
+  do {
+    reader.skipWhitespace();
+    const char* row = reader.p;
+    if (!reader.skipValue()) return 400;
+
+    char deviceId[64], userId[64];
+    JsonField fields[] = {
+      { "device_id", deviceId, sizeof(deviceId), false },
+      { "user_id", userId, sizeof(userId), false },
+    };
+    if (!parseJsonFields(row, reader.p - row, fields, 2, length)) return 400;
+    if (userIdRequired && !fields[1].found) return 400;
+    if (!fields[0].found || !deviceKnown(deviceId)) return 409;
+    rows++;
+  } while (array && reader.consume(','));
+  if (array && !reader.consume(']')) return 400;
+  inserted += rows;
+  return 201;
+}
+
+// POST /functions/v1/ingest-readings
+static int ingestReadings(const char* payload, size_t length) {
+  ReadingBatchDecoder decoder((const uint8_t*)payload, length);
+  if (!decoder.begin()) return 400;
+  StoredReading row;
+  uint32_t rows = 0;
+  while (decoder.next(row)) rows++;
+  if (!decoder.done()) return 400;
+  if (!deviceKnown(decoder.deviceId)) return 404;
+  httpStats.readings += rows;
+  return 201;
+}
+
+int httpPost(const char* endpoint, const char* payload, size_t length) {
+  httpStats.requests++;
+  httpStats.bytes += length;
+
+  int status;
+  if (faultDue()) {
+    status = faultStatus;
+  } else if (strcmp(endpoint, "/rest/v1/devices") == 0) {
+    status = insertDevice(payload, length);
+  } else if (strcmp(endpoint, "/rest/v1/alerts") == 0) {
+    status = insertRows(payload, length, true, httpStats.alerts);
+  } else if (strcmp(endpoint, "/rest/v1/device_readings") == 0) {
+    status = insertRows(payload, length, false, httpStats.readings);
+  } else if (strcmp(endpoint, "/functions/v1/ingest-readings") == 0) {
+    status = ingestReadings(payload, length);
+  } else {
+    status = 404;
+  }
+  if (status >= 400) httpStats.failures++;
+  return status;
+}
+
+void setHttpFaults(float rate, int status) {
+  faultRate = rate;
+  faultStatus = status;
+}
+
+HttpSinkStats httpSinkStats() { return httpStats; }
+
+void resetHttpSink() {
+  httpStats = { 0, 0, 0, 0, 0, 0 };
+  registeredDevices.clear();
+  faultState = 1;
+}
@@ -0,0 +1,50 @@
+#pragma once
+// Minimal stand-ins for the Arduino/ESP32 services the firmware uses, so the
+// portable core can be driven and measured on a Linux host.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ==================== CLOCK ====================
+// Simulated millis(); only moves when advanceMillis() is called
+uint32_t millis();
+void advanceMillis(uint32_t ms);
+void resetMillis();
+
+// ==================== ADC ====================
+// analogRead() returns whatever the installed source produces for the
+// current simulated time; without a source it reads 0.
+typedef uint16_t (*AdcSource)(uint32_t now, void* context);
+void setAdcSource(AdcSource source, void* context);
+uint16_t analogRead(uint8_t pin);
+
+// ==================== ALLOCATIONS ====================
+// Counts every global operator new since the last reset
+struct AllocationStats {
+  uint64_t count;
+  uint64_t bytes;
+};
+AllocationStats allocationStats();
+void resetAllocationStats();
+
+// ==================== SUPABASE STAND-IN ====================
+// In-process stand-in for the Supabase endpoints the firmware posts to. It
+// answers the way PostgREST and the ingest-readings function would: a
+// devices row is created once (409 after that), alerts and readings must
+// reference a registered device (409 for the foreign key, 404 for a binary
+// batch), alerts need a user_id (400, NOT NULL) and malformed bodies get a
+// 400. Accepted rows are counted per table.
+struct HttpSinkStats {
+  uint32_t requests;
+  uint64_t bytes;
+  uint32_t failures; // Requests answered with a status >= 400
+  uint32_t devices;  // Rows accepted per table
+  uint32_t alerts;
+  uint32_t readings;
+};
+int httpPost(const char* endpoint, const char* payload, size_t length);
+// Answers this share of requests with status before looking at them, as an
+// overloaded or unreachable backend would; the sequence is fixed per reset
+void setHttpFaults(float rate, int status);
+HttpSinkStats httpSinkStats();
+void resetHttpSink();
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""Embeds the captive portal pages into portal_pages.h.
+
+Static pages are gzipped and served straight from flash with
+Content-Encoding: gzip. Templates keep their {{name}} placeholders and are
+stored uncompressed so the firmware can substitute values while streaming.
+Re-run after editing any .html file here:
+
+    python3 firmware/portal/embed_pages.py
+"""
+import gzip
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# (source file, C identifier, gzip)
+PAGES = [
+    ("setup.html", "SETUP_PAGE_GZ", True),
+    ("chrome_intent.html", "CHROME_INTENT_PAGE_GZ", True),
+    ("connected.html", "CONNECTED_PAGE_TEMPLATE", False),
+]
+
+
+def main():
+    out = [
+        "#pragma once",
+        "// Generated by embed_pages.py from the .html files next to it; do not edit.",
+        "",
+        "#include <Arduino.h>",
+        "",
+    ]
+    for source, name, compress in PAGES:
+        with open(os.path.join(HERE, source), "rb") as f:
+            raw = f.read()
+        if compress:
+            # mtime=0 keeps the output identical between runs
+            data = gzip.compress(raw, compresslevel=9, mtime=0)
+            out.append("// %s: %d bytes, %d gzipped" % (source, len(raw), len(data)))
+            out.append("const uint8_t %s[] PROGMEM = {" % name)
+            for i in range(0, len(data), 16):
+                out.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+            out.append("};")
+        else:
+            out.append("// %s: %d bytes, template" % (source, len(raw)))
+            out.append('const char %s[] PROGMEM = R"page(%s)page";' % (name, raw.decode("utf-8")))
+        out.append("")
+    with open(os.path.join(HERE, "portal_pages.h"), "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
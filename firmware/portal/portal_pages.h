@@ -0,0 +1,205 @@
+#pragma once
+// Generated by embed_pages.py from the .html files next to it; do not edit.
+
+#include <Arduino.h>
+
+// setup.html: 3902 bytes, 1478 gzipped
+const uint8_t SETUP_PAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x57, 0xdb, 0x8e, 0xe4, 0x34,
+  0x10, 0x7d, 0xdf, 0xaf, 0x30, 0x19, 0xad, 0xba, 0x1b, 0x3a, 0xe9, 0xf4, 0x7d, 0xe8, 0x9b, 0xd8,
+  0xcb, 0x2c, 0x8c, 0xb4, 0xbb, 0x42, 0x0c, 0x2b, 0xc4, 0x13, 0x72, 0x12, 0xa7, 0xe3, 0x9d, 0xc4,
+  0xce, 0xc6, 0xce, 0xf4, 0x34, 0x68, 0x24, 0x1e, 0xf8, 0x03, 0x90, 0x78, 0xe4, 0x0d, 0x9e, 0xf9,
+  0x25, 0xbe, 0x80, 0x4f, 0xa0, 0x6c, 0xe7, 0xda, 0x97, 0x65, 0x57, 0x23, 0x4d, 0xfb, 0x52, 0xae,
+  0x3a, 0x75, 0xaa, 0x5c, 0xe5, 0xac, 0x3e, 0x09, 0xb8, 0x2f, 0xf7, 0x29, 0x41, 0x91, 0x4c, 0xe2,
+  0xcd, 0xa3, 0x55, 0xf9, 0x43, 0x70, 0xb0, 0x79, 0x84, 0xd0, 0x2a, 0x21, 0x12, 0x23, 0x3f, 0xc2,
+  0x99, 0x20, 0x72, 0x6d, 0xe5, 0x32, 0xb4, 0x2f, 0xad, 0x7a, 0x83, 0xe1, 0x84, 0xac, 0xad, 0x3b,
+  0x4a, 0x76, 0x29, 0xcf, 0xa4, 0x85, 0x7c, 0xce, 0x24, 0x61, 0x20, 0xb8, 0xa3, 0x81, 0x8c, 0xd6,
+  0x01, 0xb9, 0xa3, 0x3e, 0xb1, 0xf5, 0xa4, 0x4f, 0x19, 0x95, 0x14, 0xc7, 0xb6, 0xf0, 0x71, 0x4c,
+  0xd6, 0xc3, 0x23, 0x2d, 0x32, 0x22, 0x09, 0xb1, 0x7d, 0x1e, 0xf3, 0xac, 0xa1, 0xe8, 0xc2, 0x75,
+  0xe7, 0x5e, 0x18, 0x1a, 0x69, 0x49, 0x65, 0x4c, 0x36, 0x37, 0x09, 0xce, 0xe4, 0x97, 0x58, 0xa0,
+  0x1b, 0x22, 0xf3, 0x74, 0x35, 0x30, 0xab, 0x6a, 0x5f, 0xc8, 0xbd, 0x19, 0x21, 0xf4, 0x29, 0xfa,
+  0x09, 0x79, 0xfc, 0xde, 0x16, 0xf4, 0x47, 0xca, 0xb6, 0x0b, 0x18, 0x67, 0x01, 0xc9, 0x6c, 0x58,
+  0x5a, 0xa2, 0x07, 0x2d, 0xe1, 0xf1, 0x60, 0x0f, 0x42, 0x7a, 0x8c, 0x50, 0x08, 0x06, 0xed, 0x10,
+  0x27, 0x34, 0xde, 0x2f, 0x90, 0x8d, 0xd3, 0x34, 0x26, 0xb6, 0xd8, 0x0b, 0x49, 0x92, 0x3e, 0x7a,
+  0x1a, 0x53, 0x76, 0xfb, 0x0a, 0xfb, 0x37, 0x7a, 0xfe, 0x02, 0x24, 0xfb, 0xa8, 0x73, 0x43, 0xb6,
+  0x9c, 0xa0, 0x37, 0xd7, 0x9d, 0x3e, 0xfa, 0x86, 0x7b, 0x5c, 0xf2, 0x3e, 0x12, 0x98, 0x09, 0x5b,
+  0x90, 0x8c, 0x86, 0xcb, 0x52, 0xad, 0x87, 0xfd, 0xdb, 0x6d, 0xc6, 0x73, 0x16, 0x2c, 0x10, 0x68,
+  0x21, 0x38, 0xb3, 0xb7, 0x19, 0x0e, 0x28, 0xf8, 0xd6, 0x1d, 0x8e, 0xa7, 0x01, 0xd9, 0xf6, 0xd1,
+  0xc5, 0x6c, 0x36, 0x27, 0x04, 0x23, 0xf7, 0x31, 0x8c, 0xe7, 0xb3, 0x89, 0x87, 0x47, 0x68, 0xe8,
+  0xba, 0x8f, 0x7b, 0xcb, 0x42, 0x09, 0xf8, 0xbb, 0xa5, 0x6c, 0x81, 0xdc, 0x4a, 0x6d, 0x8a, 0x83,
+  0x40, 0xbb, 0x35, 0x72, 0xd3, 0xfb, 0x52, 0x2c, 0xa0, 0x22, 0x8d, 0x31, 0xc0, 0x0f, 0x63, 0x52,
+  0x2d, 0xe2, 0x98, 0x6e, 0x99, 0x4d, 0x01, 0xb7, 0x58, 0x20, 0x1f, 0xcc, 0x92, 0xac, 0xdc, 0x7a,
+  0x9b, 0x0b, 0x49, 0xc3, 0xbd, 0x5d, 0x70, 0x7d, 0xb8, 0x9d, 0x50, 0x66, 0x47, 0x84, 0x6e, 0x23,
+  0xd8, 0x01, 0x38, 0x77, 0x51, 0xb9, 0xa1, 0x43, 0xb4, 0x40, 0x17, 0xe3, 0xf1, 0xd8, 0x2c, 0x19,
+  0x3e, 0x1d, 0x1f, 0x67, 0x41, 0x4d, 0x68, 0xd3, 0xf3, 0x5d, 0x04, 0x00, 0x8e, 0xc1, 0x8f, 0x15,
+  0xf8, 0x4a, 0xde, 0x04, 0x48, 0x91, 0x93, 0x8b, 0xc2, 0xb1, 0x7a, 0x0f, 0x02, 0x19, 0xe1, 0x80,
+  0xef, 0x80, 0x04, 0xbd, 0x85, 0x26, 0xea, 0x5f, 0xb6, 0xf5, 0x70, 0xd7, 0xed, 0xeb, 0x3f, 0x67,
+  0xd8, 0xab, 0xe4, 0x75, 0xc2, 0x69, 0xd4, 0x8f, 0xab, 0xb5, 0x04, 0xdf, 0xdb, 0xc5, 0xfa, 0x64,
+  0xda, 0x60, 0x4d, 0x92, 0x7b, 0x69, 0x6b, 0x96, 0xda, 0x04, 0x14, 0x4e, 0xc5, 0x7c, 0xcb, 0x0f,
+  0xb2, 0x04, 0x52, 0x8a, 0x80, 0x92, 0xcb, 0x06, 0x40, 0x13, 0x21, 0xc8, 0x2e, 0x29, 0x79, 0xa2,
+  0x0c, 0x57, 0x7b, 0x46, 0x4d, 0x34, 0xac, 0x75, 0x94, 0xf4, 0x8d, 0x82, 0xf1, 0x7c, 0x72, 0x79,
+  0xa0, 0x42, 0xf9, 0xe7, 0xea, 0xf3, 0x10, 0xed, 0xa6, 0xd1, 0x5d, 0x11, 0x89, 0xb9, 0xeb, 0xb6,
+  0xf0, 0x15, 0x57, 0x8c, 0x02, 0xf3, 0x27, 0x88, 0xbf, 0x08, 0xe7, 0x21, 0x0e, 0xfd, 0xe5, 0x21,
+  0xf3, 0xc3, 0x06, 0x01, 0x07, 0xc4, 0x37, 0xb7, 0x0e, 0xdc, 0x1a, 0x4d, 0xeb, 0xad, 0xd6, 0x7d,
+  0x49, 0x38, 0xe3, 0x22, 0xc5, 0x3e, 0x59, 0x1e, 0xf3, 0x34, 0x9c, 0xd4, 0x87, 0x4a, 0xd7, 0x27,
+  0x78, 0x3a, 0x9d, 0x5d, 0x36, 0xfd, 0x88, 0xb1, 0x47, 0xe2, 0x9a, 0xa3, 0x2a, 0x95, 0xbd, 0x98,
+  0xfb, 0xb7, 0x15, 0x47, 0xcd, 0x58, 0xc5, 0x24, 0x94, 0xe7, 0xcc, 0xa1, 0x53, 0xcc, 0xcd, 0x5c,
+  0xf7, 0xc0, 0x2f, 0xc9, 0x53, 0x38, 0x30, 0x3d, 0x1f, 0xc7, 0xe9, 0x87, 0x40, 0xa7, 0x2c, 0xcd,
+  0x65, 0x0d, 0xfd, 0x54, 0xee, 0xd5, 0xbc, 0x8f, 0x20, 0xb0, 0xa7, 0x2c, 0x6a, 0x28, 0xd3, 0xf3,
+  0xd7, 0x61, 0x78, 0x7c, 0x55, 0x20, 0x1e, 0xa0, 0x4c, 0xf0, 0x18, 0x62, 0x7f, 0x41, 0x46, 0xe4,
+  0x32, 0x74, 0x97, 0x27, 0xf2, 0x74, 0x38, 0x2b, 0x9d, 0x68, 0xc0, 0x5d, 0x84, 0xdc, 0xcf, 0x45,
+  0x95, 0x32, 0x3c, 0x97, 0xaa, 0x38, 0x2d, 0x10, 0xe3, 0x8c, 0x1c, 0xe4, 0x45, 0xe9, 0xb8, 0xa9,
+  0xc3, 0x4d, 0x4d, 0x5e, 0x0e, 0x2c, 0xb1, 0xda, 0xf3, 0xa6, 0x2b, 0xa3, 0xa6, 0x2f, 0xef, 0xa7,
+  0xe4, 0x63, 0xbd, 0x76, 0x3f, 0xae, 0xb8, 0x1a, 0xdc, 0x7a, 0x30, 0x9d, 0x79, 0xe3, 0xde, 0x41,
+  0x40, 0xdb, 0xa5, 0xe9, 0x90, 0xb7, 0xff, 0x4b, 0x24, 0x3f, 0xcf, 0x84, 0xd2, 0x92, 0x72, 0x7a,
+  0x54, 0x39, 0x28, 0x13, 0x32, 0xcb, 0x7d, 0x49, 0x39, 0x13, 0x67, 0x2e, 0x67, 0x18, 0x8e, 0xfd,
+  0x60, 0x79, 0xe0, 0xdf, 0xb0, 0x8e, 0x6a, 0x18, 0x12, 0x8c, 0xe7, 0x1f, 0x70, 0x51, 0xdb, 0x6c,
+  0x9e, 0xb9, 0xbd, 0x67, 0x8a, 0xde, 0xfb, 0x2e, 0x52, 0xe5, 0xcf, 0x6a, 0x50, 0xf4, 0xd6, 0xd5,
+  0xc0, 0x3c, 0x0d, 0x56, 0xaa, 0x7d, 0xea, 0xa6, 0x1b, 0xd0, 0x3b, 0xe4, 0xc7, 0x58, 0x88, 0xb5,
+  0xa5, 0x3a, 0x80, 0x65, 0xfa, 0x6f, 0x73, 0x59, 0xd5, 0x50, 0x6b, 0xf3, 0xef, 0x1f, 0xbf, 0xfd,
+  0xb5, 0x1a, 0xc0, 0x72, 0x21, 0x10, 0x0d, 0x8f, 0x3a, 0x39, 0x2c, 0x1d, 0x1d, 0xae, 0x0a, 0x5c,
+  0xa1, 0x18, 0xa1, 0xe7, 0x7a, 0x05, 0x5d, 0x3f, 0x5f, 0x40, 0xc7, 0x4f, 0x31, 0x43, 0x34, 0x68,
+  0x89, 0xfd, 0xf3, 0xf3, 0x9f, 0x00, 0x17, 0x36, 0x0a, 0x65, 0xc6, 0xe6, 0x91, 0xe2, 0x66, 0x7c,
+  0x2a, 0xdd, 0xab, 0x68, 0x0c, 0x40, 0x7f, 0xfd, 0xdb, 0x20, 0x42, 0xd7, 0x0d, 0x99, 0x05, 0xe0,
+  0x1b, 0x57, 0x72, 0xe9, 0x66, 0xe8, 0x80, 0x50, 0x4c, 0x7c, 0x89, 0xf6, 0x3c, 0xcf, 0xd0, 0x77,
+  0xd4, 0x7e, 0x41, 0x11, 0x23, 0x72, 0xc7, 0xb3, 0x5b, 0x04, 0xd5, 0x8c, 0xef, 0x56, 0x83, 0xb4,
+  0x21, 0x3f, 0x72, 0xd0, 0x95, 0x4a, 0x92, 0xa6, 0x78, 0x0a, 0x48, 0x40, 0x3e, 0x68, 0x4b, 0x8e,
+  0x1d, 0xf4, 0x24, 0x08, 0xf4, 0x1b, 0x08, 0x83, 0x7a, 0xca, 0x42, 0x0e, 0x91, 0xc9, 0xa0, 0x97,
+  0x93, 0x4c, 0x0a, 0xd4, 0xe5, 0xa9, 0x02, 0x84, 0xe3, 0x5e, 0xfb, 0xd8, 0xc4, 0x41, 0xcf, 0x62,
+  0xea, 0xdf, 0xaa, 0x77, 0x50, 0xc6, 0xd9, 0x76, 0xf3, 0x8c, 0x33, 0xa6, 0xf0, 0x19, 0xc2, 0x54,
+  0x08, 0xf5, 0x72, 0x75, 0xaa, 0xc5, 0x0c, 0x18, 0x48, 0x10, 0xd6, 0xae, 0xae, 0xad, 0x81, 0x6f,
+  0x8e, 0x5a, 0x08, 0x1e, 0x68, 0x11, 0x07, 0x7e, 0x53, 0x2e, 0x64, 0xcd, 0x92, 0x29, 0xd7, 0x70,
+  0x64, 0x6d, 0x09, 0xa1, 0x38, 0x37, 0xee, 0xbc, 0x36, 0xde, 0xaf, 0x06, 0x7a, 0xbf, 0x92, 0x36,
+  0x15, 0x52, 0x45, 0x49, 0x0b, 0x17, 0xef, 0x3d, 0x33, 0x86, 0x32, 0xef, 0x93, 0x88, 0xc7, 0x90,
+  0xd9, 0x6b, 0xeb, 0xfb, 0x63, 0x22, 0x95, 0xac, 0x85, 0x32, 0xf2, 0x2e, 0xa7, 0x19, 0x09, 0x10,
+  0xce, 0x25, 0xd7, 0xb5, 0xab, 0x80, 0xdd, 0xc6, 0x52, 0xd2, 0x59, 0xe2, 0xf9, 0xba, 0xa2, 0xf7,
+  0x1c, 0xa0, 0xea, 0x44, 0x01, 0xaa, 0x9e, 0xab, 0x47, 0x71, 0x73, 0x7e, 0x0e, 0x68, 0x2d, 0x51,
+  0x82, 0x3c, 0x09, 0x8d, 0x24, 0x98, 0xc6, 0xd6, 0xe6, 0x4a, 0xfd, 0xa8, 0xe8, 0x66, 0x44, 0xb4,
+  0x23, 0x79, 0x0e, 0xa1, 0x39, 0x58, 0xc0, 0x2b, 0x26, 0x06, 0x5b, 0x31, 0x69, 0x01, 0x83, 0xdc,
+  0xfa, 0x82, 0xdc, 0xe3, 0x04, 0x9e, 0xaf, 0x8e, 0xcf, 0x13, 0xeb, 0x24, 0x96, 0x84, 0x7b, 0x34,
+  0x26, 0xd6, 0xe6, 0x95, 0xfe, 0x45, 0xaf, 0xf3, 0xc4, 0x83, 0xb4, 0xfc, 0x10, 0x30, 0xc5, 0xc9,
+  0x02, 0x4d, 0x39, 0x6b, 0x21, 0xf8, 0x6c, 0x38, 0x1a, 0x4f, 0xa6, 0xb3, 0xf9, 0xe5, 0xe7, 0xee,
+  0x69, 0xeb, 0xb9, 0x7a, 0x21, 0x43, 0x88, 0xde, 0xc0, 0x2f, 0x5c, 0x62, 0xd4, 0x2d, 0x79, 0x7b,
+  0x8f, 0xdd, 0xe2, 0x4c, 0x61, 0xb7, 0x9c, 0xb5, 0xec, 0x36, 0xee, 0x56, 0xa1, 0xf9, 0x54, 0x44,
+  0x8a, 0x9e, 0x65, 0x08, 0x14, 0xb9, 0x97, 0x50, 0xa9, 0x2b, 0xd3, 0xef, 0xe8, 0xf0, 0xb2, 0x18,
+  0xc9, 0xf2, 0xa2, 0xa8, 0xdb, 0xa1, 0xab, 0x5d, 0x75, 0x65, 0x56, 0xc2, 0xcf, 0x68, 0x2a, 0x8d,
+  0x00, 0x7c, 0x44, 0xe5, 0x09, 0xb4, 0x1d, 0x67, 0x4b, 0xe4, 0x55, 0x4c, 0xd4, 0xf0, 0xe9, 0xfe,
+  0x3a, 0xe8, 0x76, 0x54, 0x92, 0x77, 0x7a, 0x8e, 0x4e, 0xd9, 0x2e, 0xf4, 0x1e, 0x2d, 0x1d, 0x12,
+  0xe9, 0x47, 0xdd, 0xce, 0x00, 0xa7, 0x14, 0xee, 0x24, 0x96, 0xb9, 0xe8, 0xf4, 0x0a, 0x80, 0x0e,
+  0x7c, 0x05, 0xb1, 0x6e, 0x98, 0x33, 0x7d, 0x11, 0x81, 0x1a, 0x91, 0x42, 0xe9, 0x21, 0x3d, 0xe8,
+  0xb2, 0x19, 0x54, 0xa4, 0x8c, 0xa1, 0x72, 0xc9, 0x79, 0x2b, 0x40, 0x00, 0xde, 0xbc, 0x0f, 0x67,
+  0xce, 0x1a, 0xcd, 0xea, 0xe4, 0x59, 0x74, 0x55, 0xd1, 0x04, 0x88, 0xaa, 0x25, 0x3c, 0x33, 0x5f,
+  0x02, 0x68, 0x8d, 0xcc, 0xe1, 0xe2, 0x75, 0xf9, 0x03, 0x0d, 0x9a, 0x66, 0x7c, 0xac, 0xe0, 0x57,
+  0x76, 0xc0, 0xc2, 0x43, 0xe9, 0x59, 0x65, 0xe9, 0x5d, 0x4e, 0xb2, 0xbd, 0x29, 0x8f, 0x3c, 0xeb,
+  0x76, 0x14, 0x7d, 0x60, 0x03, 0xba, 0xd4, 0xd5, 0x1d, 0x6c, 0xbf, 0xa4, 0xf0, 0x21, 0xc5, 0x08,
+  0x6c, 0x98, 0x10, 0xc0, 0x37, 0x54, 0x53, 0x5d, 0xd5, 0xa1, 0xa1, 0xfa, 0x96, 0xaf, 0x8c, 0xf5,
+  0x59, 0xdd, 0x46, 0xa0, 0x53, 0x35, 0x76, 0x33, 0x87, 0xf6, 0x0b, 0x06, 0xbe, 0xfa, 0xf6, 0xd5,
+  0x4b, 0x38, 0xda, 0x81, 0x08, 0xff, 0x52, 0x46, 0x18, 0xfa, 0xa4, 0xe3, 0x38, 0x9d, 0x03, 0x71,
+  0x78, 0x71, 0x62, 0x2f, 0x86, 0x0a, 0xb3, 0x46, 0x50, 0xf1, 0x8b, 0x47, 0xd0, 0x83, 0x56, 0x0a,
+  0x85, 0xb3, 0x08, 0x35, 0x64, 0x85, 0xee, 0x7a, 0xd0, 0x09, 0xf4, 0x67, 0xf2, 0x7f, 0xec, 0x13,
+  0xe6, 0x55, 0x3e, 0x0f, 0x00, 0x00,
+};
+
+// chrome_intent.html: 2368 bytes, 1090 gzipped
+const uint8_t CHROME_INTENT_PAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x56, 0xcd, 0x6e, 0xe3, 0x36,
+  0x10, 0xbe, 0xe7, 0x29, 0xa6, 0x0a, 0x02, 0x27, 0x58, 0xcb, 0xb2, 0x63, 0xc7, 0xc9, 0xda, 0xb2,
+  0x0f, 0x09, 0x76, 0xb7, 0x7b, 0x28, 0xba, 0x68, 0xb6, 0x0f, 0x40, 0x4b, 0x23, 0x89, 0x8d, 0x24,
+  0xaa, 0x24, 0x1d, 0xc7, 0xbb, 0x28, 0xd0, 0x07, 0xe8, 0xa1, 0x40, 0x6f, 0xbd, 0xf4, 0x19, 0xfa,
+  0x66, 0x7d, 0x84, 0x0e, 0x49, 0xfd, 0xd9, 0x0e, 0x8a, 0xc2, 0xb0, 0x45, 0x71, 0x38, 0xc3, 0x6f,
+  0xbe, 0xf9, 0x38, 0x74, 0xf8, 0x4d, 0x2c, 0x22, 0xbd, 0xaf, 0x10, 0x32, 0x5d, 0xe4, 0xeb, 0xb3,
+  0xb0, 0x79, 0x20, 0x8b, 0xd7, 0x67, 0x00, 0x61, 0x81, 0x9a, 0x41, 0x94, 0x31, 0xa9, 0x50, 0xaf,
+  0xbc, 0xad, 0x4e, 0xfc, 0x3b, 0xaf, 0x33, 0x94, 0xac, 0xc0, 0x95, 0xf7, 0xcc, 0x71, 0x57, 0x09,
+  0xa9, 0x3d, 0x88, 0x44, 0xa9, 0xb1, 0xa4, 0x85, 0x3b, 0x1e, 0xeb, 0x6c, 0x15, 0xe3, 0x33, 0x8f,
+  0xd0, 0xb7, 0x2f, 0x43, 0x5e, 0x72, 0xcd, 0x59, 0xee, 0xab, 0x88, 0xe5, 0xb8, 0x9a, 0xb8, 0x28,
+  0x9a, 0xeb, 0x1c, 0xd7, 0x8f, 0x05, 0x93, 0xfa, 0x03, 0x53, 0xf0, 0x88, 0x7a, 0x5b, 0x81, 0x0f,
+  0xdf, 0x57, 0x58, 0x02, 0x2f, 0xe1, 0x21, 0x93, 0xa2, 0xc0, 0x30, 0x70, 0xcb, 0x8c, 0x83, 0xd2,
+  0x7b, 0x37, 0x02, 0xd8, 0x88, 0x78, 0x0f, 0x5f, 0xc1, 0x8e, 0x01, 0x12, 0xda, 0xda, 0x4f, 0x58,
+  0xc1, 0xf3, 0xfd, 0x02, 0x7c, 0x56, 0x55, 0x39, 0xfa, 0x6a, 0xaf, 0x34, 0x16, 0x43, 0xb8, 0xcf,
+  0x79, 0xf9, 0xf4, 0x1d, 0x8b, 0x1e, 0xed, 0xfb, 0x7b, 0x5a, 0x39, 0x84, 0xc1, 0x23, 0xa6, 0x02,
+  0xe1, 0xc7, 0x8f, 0x83, 0x21, 0xfc, 0x20, 0x36, 0x42, 0x8b, 0x21, 0x28, 0x56, 0x2a, 0x5f, 0xa1,
+  0xe4, 0xc9, 0xb2, 0x09, 0xbb, 0x61, 0xd1, 0x53, 0x2a, 0xc5, 0xb6, 0x8c, 0x17, 0x40, 0x51, 0x90,
+  0x49, 0x3f, 0x95, 0x2c, 0xe6, 0x94, 0xe5, 0xe5, 0x64, 0x7a, 0x13, 0x63, 0x3a, 0x84, 0xf3, 0xf9,
+  0xfc, 0x16, 0x91, 0xc1, 0xf8, 0x82, 0xc6, 0xb7, 0xf3, 0xd9, 0x86, 0x5d, 0xc3, 0x64, 0x3c, 0xbe,
+  0xb8, 0x5a, 0xd6, 0x41, 0x28, 0xbd, 0x94, 0x97, 0x0b, 0x18, 0xb7, 0x61, 0x2b, 0x16, 0xc7, 0xbc,
+  0x4c, 0x17, 0x70, 0x3d, 0xae, 0x5e, 0x9a, 0x65, 0x31, 0x57, 0x55, 0xce, 0x08, 0x7e, 0x92, 0x63,
+  0x3b, 0xc9, 0x72, 0x9e, 0x96, 0x3e, 0x27, 0xdc, 0x6a, 0x01, 0x11, 0x6d, 0x8b, 0xb2, 0x31, 0xfd,
+  0xb4, 0x55, 0x9a, 0x27, 0x7b, 0xbf, 0x66, 0xfd, 0xd8, 0x5c, 0xf0, 0xd2, 0xcf, 0x90, 0xa7, 0x19,
+  0x59, 0x08, 0xce, 0x73, 0xd6, 0x18, 0x22, 0x91, 0x0b, 0xb9, 0x80, 0xf3, 0xe9, 0x74, 0xea, 0xa6,
+  0x7e, 0xb1, 0xbf, 0xa3, 0x88, 0xc9, 0xb8, 0x23, 0xb4, 0x9f, 0xf9, 0x2e, 0x23, 0x00, 0xa7, 0xe0,
+  0xa7, 0x06, 0x7c, 0xbb, 0x5e, 0xc8, 0x18, 0xa5, 0x6f, 0xc8, 0xd9, 0xaa, 0x3a, 0xb1, 0xce, 0xf6,
+  0xe2, 0xab, 0x8c, 0xc5, 0x62, 0x47, 0x24, 0x58, 0x13, 0xcc, 0xcc, 0x8f, 0x4c, 0x37, 0xec, 0x72,
+  0x3c, 0xb4, 0x9f, 0xd1, 0xe4, 0xaa, 0x5d, 0x6f, 0x15, 0x63, 0x51, 0x5f, 0xb4, 0x73, 0x05, 0x7b,
+  0xf1, 0xeb, 0xf9, 0xd9, 0x4d, 0x8f, 0x35, 0x8d, 0x2f, 0xda, 0xb7, 0x2c, 0x1d, 0x12, 0xd0, 0x24,
+  0x65, 0x25, 0xe4, 0x73, 0x22, 0x09, 0xbe, 0xf6, 0xb5, 0xa2, 0xf8, 0x17, 0x5c, 0xc0, 0x7c, 0xd6,
+  0x45, 0x72, 0x65, 0xf2, 0x49, 0x0b, 0x5a, 0x14, 0xfd, 0xd2, 0xb8, 0x50, 0xd9, 0xa4, 0x23, 0xa7,
+  0xa1, 0xf0, 0x3a, 0x9e, 0xde, 0xce, 0xee, 0x7a, 0x18, 0xeb, 0x42, 0xd3, 0x67, 0x72, 0x43, 0x09,
+  0x8e, 0x97, 0xfd, 0x2d, 0x77, 0x75, 0x35, 0x6e, 0xc7, 0xe3, 0x03, 0x8c, 0xa4, 0xca, 0x4a, 0xb5,
+  0xe8, 0xfa, 0x09, 0xe5, 0x98, 0xe8, 0xe5, 0x2b, 0x05, 0x39, 0x4f, 0xee, 0x92, 0xb7, 0x09, 0x5b,
+  0xfe, 0x97, 0x9c, 0x8e, 0x0a, 0x32, 0x19, 0x1f, 0x67, 0xea, 0x96, 0xc3, 0x21, 0x96, 0x8d, 0xee,
+  0x78, 0x6a, 0x05, 0xc9, 0x4b, 0xa3, 0x7d, 0x7f, 0x93, 0x8b, 0xe8, 0xe9, 0x55, 0x38, 0xb3, 0xeb,
+  0xbb, 0x9b, 0x64, 0x76, 0x24, 0x30, 0xa7, 0x9a, 0x63, 0x88, 0x96, 0x97, 0xe9, 0xff, 0xc3, 0x69,
+  0xa9, 0x88, 0x31, 0x12, 0x92, 0x69, 0x2e, 0x08, 0x70, 0x29, 0x4a, 0x7c, 0x95, 0xd2, 0xf9, 0xf8,
+  0x90, 0x6a, 0x57, 0xdd, 0xc9, 0xfc, 0x34, 0x67, 0x13, 0x1f, 0x6e, 0xfa, 0xa5, 0x0d, 0x83, 0xba,
+  0xab, 0x84, 0x81, 0xeb, 0x7b, 0xa1, 0x69, 0x2d, 0xb6, 0xdd, 0xc4, 0xfc, 0x19, 0xa2, 0x9c, 0x29,
+  0xb5, 0xf2, 0xcc, 0xe9, 0xf0, 0x5c, 0xe7, 0x39, 0x98, 0xee, 0xf4, 0xe5, 0xad, 0xff, 0xf9, 0xeb,
+  0xb7, 0xdf, 0xc3, 0x80, 0xac, 0xf5, 0xba, 0x6c, 0xb2, 0x3e, 0x6c, 0x65, 0x70, 0x2f, 0xc5, 0x8e,
+  0x3a, 0x0c, 0xed, 0x34, 0xa9, 0xd7, 0x54, 0xeb, 0xf7, 0x42, 0x82, 0xce, 0x10, 0x36, 0xa8, 0x34,
+  0x28, 0xdb, 0x02, 0xf1, 0xa5, 0xa2, 0x36, 0x84, 0x65, 0x84, 0x43, 0xa0, 0x4e, 0xc6, 0x14, 0xc2,
+  0x96, 0xbe, 0x75, 0x90, 0x8d, 0x0b, 0x32, 0x0a, 0x83, 0x6a, 0x7d, 0x76, 0x82, 0xc8, 0xaa, 0xa9,
+  0x46, 0x6a, 0x30, 0x4c, 0x09, 0xd6, 0x1f, 0x7f, 0xc3, 0xb7, 0x62, 0x07, 0x5a, 0x80, 0x38, 0xc0,
+  0xb3, 0x20, 0x20, 0xd3, 0x76, 0xa9, 0xc8, 0x9b, 0x21, 0xbd, 0xe4, 0x7c, 0x4d, 0xdd, 0x56, 0x8a,
+  0x32, 0x75, 0x39, 0x34, 0xbd, 0xb8, 0x9e, 0x03, 0x6a, 0xb1, 0x40, 0x67, 0x6a, 0x2f, 0xb6, 0x12,
+  0xaa, 0x8c, 0xea, 0x12, 0x06, 0xe4, 0x72, 0xe0, 0xff, 0xd9, 0x5c, 0x2c, 0x3a, 0xe3, 0x0a, 0xa8,
+  0xf8, 0x12, 0x95, 0x32, 0x1b, 0x9b, 0x4c, 0x9b, 0xd7, 0x0d, 0x93, 0x8b, 0x13, 0x37, 0xb0, 0xd5,
+  0x58, 0x79, 0xaf, 0x1c, 0xec, 0xae, 0x88, 0xee, 0x70, 0x79, 0x9d, 0x23, 0xb9, 0x46, 0x22, 0xc6,
+  0xc6, 0xf9, 0x40, 0x9d, 0xf8, 0x16, 0x23, 0xa4, 0x9e, 0xde, 0x6a, 0xf0, 0x8e, 0xbc, 0x4d, 0x88,
+  0xe5, 0xb1, 0xf8, 0xec, 0x5c, 0x5f, 0x40, 0xa6, 0x3d, 0x78, 0x44, 0x44, 0xc5, 0xca, 0x86, 0x5f,
+  0x73, 0xd5, 0xd1, 0x3d, 0x96, 0x09, 0xa5, 0xc9, 0x12, 0x18, 0x13, 0x3d, 0xcc, 0xe6, 0xbd, 0x34,
+  0x4e, 0xb8, 0xf8, 0x64, 0x13, 0x6e, 0x18, 0xfd, 0x20, 0x3a, 0x22, 0xa9, 0xfa, 0xcd, 0xf4, 0x3b,
+  0x93, 0x65, 0x6b, 0x39, 0x0d, 0xf2, 0x20, 0x0a, 0x52, 0x83, 0x46, 0x4b, 0xa2, 0x53, 0x4a, 0x22,
+  0x64, 0xd1, 0x5f, 0x18, 0x06, 0x4d, 0x15, 0x6b, 0x21, 0xba, 0x31, 0x03, 0x1e, 0x93, 0x34, 0x8c,
+  0x8b, 0x6f, 0x6e, 0x43, 0x0f, 0x32, 0x89, 0xc9, 0xca, 0x0b, 0xbc, 0x26, 0x2d, 0x3a, 0xf8, 0x46,
+  0xc0, 0x7f, 0xfe, 0xea, 0x6e, 0x5f, 0x77, 0x15, 0x7f, 0x62, 0x29, 0xd5, 0x95, 0xd9, 0xb3, 0xd0,
+  0x86, 0x0b, 0x55, 0x24, 0x79, 0xa5, 0xdd, 0x2e, 0x41, 0x00, 0x9f, 0x09, 0x8c, 0x23, 0x05, 0x4c,
+  0xa9, 0xf3, 0x1d, 0xdb, 0x2b, 0x90, 0xc8, 0xa2, 0x0c, 0x63, 0x42, 0x4a, 0x55, 0x48, 0x33, 0x8b,
+  0x38, 0x13, 0x5a, 0x55, 0x42, 0x37, 0xe5, 0xb7, 0xfe, 0xcf, 0x4c, 0x82, 0xa1, 0x12, 0x56, 0x40,
+  0xdd, 0xc5, 0x1e, 0xf3, 0x91, 0x79, 0x77, 0xc7, 0x93, 0xfe, 0x9d, 0x6c, 0x0b, 0xaa, 0xfd, 0xe8,
+  0xe7, 0x2d, 0xca, 0xfd, 0x23, 0xe6, 0x18, 0x69, 0x21, 0x2f, 0x07, 0xa3, 0x5e, 0x11, 0x06, 0x57,
+  0x23, 0x23, 0x95, 0x07, 0x77, 0x0b, 0x52, 0x9c, 0x57, 0xdc, 0x53, 0xd4, 0xef, 0x72, 0x34, 0xc3,
+  0xfb, 0xfd, 0xc7, 0xf8, 0x72, 0xd0, 0x11, 0x41, 0xde, 0x86, 0x09, 0x72, 0x1b, 0x64, 0x5a, 0x57,
+  0x8b, 0x20, 0x18, 0xc0, 0x1b, 0x87, 0xe8, 0x0d, 0x0c, 0x82, 0xc1, 0xd2, 0x35, 0x88, 0x3a, 0xe3,
+  0x30, 0x70, 0xad, 0x81, 0x8e, 0x8d, 0xfd, 0xa3, 0xf4, 0x2f, 0x31, 0xeb, 0x57, 0x4c, 0x40, 0x09,
+  0x00, 0x00,
+};
+
+// connected.html: 953 bytes, template
+const char CONNECTED_PAGE_TEMPLATE[] PROGMEM = R"page(<!doctype html>
+<html>
+<head>
+  <meta charset="utf-8">
+  <meta name="viewport" content="width=device-width,initial-scale=1">
+  <title>SmartGas - Success</title>
+  <style>
+    body { font-family: Arial; background: #f0f9ff; display: flex; align-items: center; justify-content: center; height: 100vh; margin: 0; }
+    .card { background: white; padding: 30px; border-radius: 15px; box-shadow: 0 8px 25px rgba(0,0,0,0.1); text-align: center; max-width: 400px; }
+    .success { color: #10b981; font-size: 48px; margin-bottom: 20px; }
+    h2 { color: #059669; margin: 0 0 15px 0; }
+  </style>
+  <script>
+    setTimeout(function() {
+      window.close();
+    }, 3000);
+  </script>
+</head>
+<body>
+  <div class="card">
+    <div class="success">✅</div>
+    <h2>Wi-Fi Saved Successfully!</h2>
+    <p>Device is connecting to your network...</p>
+    <p><strong>SSID:</strong> {{ssid}}</p>
+    <p>This window will close automatically.</p>
+  </div>
+</body>
+</html>
+)page";
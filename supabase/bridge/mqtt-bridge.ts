@@ -0,0 +1,107 @@
+// Long-running bridge from the detectors' MQTT topics into the alerts and
+// device_readings tables. Devices publish the same bodies they would POST
+// to PostgREST (see the MQTT TRANSPORT section of esp32_main.cpp):
+//
+//   gasguardian/<device_id>/alerts        alerts row (JSON object), QoS 1
+//   gasguardian/<device_id>/readings      device_readings rows (JSON), QoS 0
+//   gasguardian/<device_id>/readings/bin  binary reading batch, QoS 0
+//   gasguardian/<device_id>/status        "online" / "offline" (retained)
+//
+// Run against a local broker:
+//   mosquitto -c supabase/bridge/mosquitto.conf
+//   MQTT_URL=mqtt://localhost:1883 SUPABASE_URL=... SUPABASE_SERVICE_ROLE_KEY=... \
+//     deno run --allow-net --allow-env supabase/bridge/mqtt-bridge.ts
+import mqtt from 'npm:mqtt@5.10.1';
+import { createClient } from 'https://esm.sh/@supabase/supabase-js@2.39.3';
+import { BatchFormatError, decodeBatch } from '../functions/_shared/reading_codec.ts';
+
+const brokerUrl = Deno.env.get('MQTT_URL') ?? 'mqtt://localhost:1883';
+const supabaseUrl = Deno.env.get('SUPABASE_URL') ?? '';
+const serviceRoleKey = Deno.env.get('SUPABASE_SERVICE_ROLE_KEY') ?? '';
+const supabase = createClient(supabaseUrl, serviceRoleKey, {
+  auth: {
+    persistSession: false,
+  },
+});
+
+const TOPIC_PREFIX = 'gasguardian';
+
+// Rows carry the device ID from the topic, so a device can only write as
+// itself once the broker restricts each client to its own topics
+async function insertRows(table: string, deviceId: string, body: unknown) {
+  const rows = (Array.isArray(body) ? body : [body]) as Record<string, unknown>[];
+  for (const row of rows) row.device_id = deviceId;
+  const { error } = await supabase.from(table).insert(rows);
+  if (error) throw new Error(`${table}: ${error.message}`);
+  return rows.length;
+}
+
+async function insertBinaryReadings(deviceId: string, payload: Uint8Array) {
+  const batch = decodeBatch(payload);
+  if (!batch.userId) {
+    const { data } = await supabase.from('devices').select('user_id').eq('id', deviceId).single();
+    if (data?.user_id) for (const row of batch.rows) row.user_id = data.user_id;
+  } else {
+    for (const row of batch.rows) row.user_id = batch.userId;
+  }
+  return insertRows('device_readings', deviceId, batch.rows);
+}
+
+async function handleMessage(topic: string, payload: Uint8Array) {
+  const [prefix, deviceId, ...rest] = topic.split('/');
+  const kind = rest.join('/');
+  if (prefix !== TOPIC_PREFIX || !deviceId) return;
+
+  switch (kind) {
+    case 'alerts':
+      await insertRows('alerts', deviceId, JSON.parse(new TextDecoder().decode(payload)));
+      console.log(`[${deviceId}] alert stored`);
+      break;
+    case 'readings': {
+      const count = await insertRows('device_readings', deviceId, JSON.parse(new TextDecoder().decode(payload)));
+      console.log(`[${deviceId}] ${count} readings stored`);
+      break;
+    }
+    case 'readings/bin': {
+      const count = await insertBinaryReadings(deviceId, payload);
+      console.log(`[${deviceId}] ${count} readings stored (binary, ${payload.length} bytes)`);
+      break;
+    }
+    case 'status':
+      console.log(`[${deviceId}] ${new TextDecoder().decode(payload)}`);
+      break;
+    default:
+      console.warn(`Ignoring ${topic}`);
+  }
+}
+
+// A persistent session makes the broker queue QoS 1 alerts while the bridge
+// is down. A message is only acked once its rows are stored. If an insert
+// fails, the ack is withheld and the bridge reconnects, so the broker
+// redelivers the message instead of losing it.
+const RETRY_DELAY_MS = 5000;
+const client = mqtt.connect(brokerUrl, {
+  clientId: Deno.env.get('MQTT_CLIENT_ID') ?? 'gasguardian-bridge',
+  username: Deno.env.get('MQTT_USERNAME'),
+  password: Deno.env.get('MQTT_PASSWORD'),
+  clean: false,
+  reconnectPeriod: RETRY_DELAY_MS,
+  customHandleAcks: (topic: string, payload: Uint8Array, _packet: unknown, done: (code: number) => void) => {
+    handleMessage(topic, payload)
+      .then(() => done(0))
+      .catch((error) => {
+        console.error(`Error handling ${topic}:`, error);
+        if (error instanceof SyntaxError || error instanceof BatchFormatError) {
+          done(0); // Malformed, would never insert
+        } else {
+          client.end(true, () => setTimeout(() => client.reconnect(), RETRY_DELAY_MS));
+        }
+      });
+  },
+});
+
+client.on('connect', () => {
+  console.log(`Bridge connected to ${brokerUrl}`);
+  client.subscribe(`${TOPIC_PREFIX}/+/#`, { qos: 1 });
+});
+client.on('error', (error) => console.error('MQTT error:', error.message));
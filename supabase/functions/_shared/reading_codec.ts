@@ -0,0 +1,107 @@
+// Decoder for the compact binary reading batches sent by the firmware.
+// The format is documented in firmware/core/reading_codec.h; keep both in
+// sync. Shared by the ingest-readings function and the MQTT bridge.
+
+const MAGIC = 0x47; // 'G'
+const VERSION = 1;
+const FLAG_TIMESTAMPS = 0x01;
+const FLAG_SUMMARY = 0x02;
+const FLAG_METRICS = 0x04;
+const SCALE = 10; // Units per ADC count
+const MAX_ROWS = 1000;
+
+// MetricsSummary fields in firmware/core/metrics.h, in encoding order.
+// Values from a newer firmware beyond this list are ignored.
+const METRICS_SUMMARY_NAMES = [
+  'uptime_s', 'free_heap', 'largest_block', 'min_free_heap', 'loop_max_us', 'requests',
+  'request_failures', 'request_avg_ms', 'tls_avg_ms', 'wifi_reconnects', 'held_alerts',
+];
+const MAX_METRICS = 64;
+
+// Thrown for bodies that can never be decoded, as opposed to storage errors
+export class BatchFormatError extends Error {}
+
+class BatchReader {
+  private offset = 0;
+  constructor(private bytes: Uint8Array) {}
+
+  byte(): number {
+    if (this.offset >= this.bytes.length) throw new BatchFormatError('Truncated batch');
+    return this.bytes[this.offset++];
+  }
+
+  varint(): number {
+    let value = 0;
+    for (let shift = 0; shift < 35; shift += 7) {
+      const byte = this.byte();
+      value += (byte & 0x7f) * 2 ** shift;
+      if ((byte & 0x80) === 0) return value;
+    }
+    throw new BatchFormatError('Varint too long');
+  }
+
+  svarint(): number {
+    const value = this.varint();
+    return value % 2 === 0 ? value / 2 : -(value + 1) / 2;
+  }
+
+  string(): string {
+    const length = this.varint();
+    if (this.offset + length > this.bytes.length) throw new BatchFormatError('Truncated batch');
+    const text = new TextDecoder().decode(this.bytes.subarray(this.offset, this.offset + length));
+    this.offset += length;
+    return text;
+  }
+
+  done(): boolean {
+    return this.offset === this.bytes.length;
+  }
+}
+
+export function decodeBatch(bytes: Uint8Array) {
+  const reader = new BatchReader(bytes);
+  if (reader.byte() !== MAGIC) throw new BatchFormatError('Not a reading batch');
+  const version = reader.byte();
+  if (version !== VERSION) throw new BatchFormatError(`Unsupported batch version ${version}`);
+  const flags = reader.byte();
+  const deviceId = reader.string();
+  const userId = reader.string();
+  let metrics: Record<string, number> | null = null;
+  if (flags & FLAG_METRICS) {
+    const fields = reader.varint();
+    if (fields > MAX_METRICS) throw new BatchFormatError('Invalid metrics summary');
+    metrics = {};
+    for (let i = 0; i < fields; i++) {
+      const value = reader.varint();
+      if (i < METRICS_SUMMARY_NAMES.length) metrics[METRICS_SUMMARY_NAMES[i]] = value;
+    }
+  }
+  const count = reader.varint();
+  if (!deviceId || count > MAX_ROWS) throw new BatchFormatError('Invalid batch header');
+
+  // Deltas are accumulated in the quantised domain, exactly as encoded
+  const rows = [];
+  let epoch = 0;
+  let level = 0;
+  for (let i = 0; i < count; i++) {
+    if (flags & FLAG_TIMESTAMPS) epoch += reader.svarint();
+    level += reader.svarint();
+    const row: Record<string, unknown> = {
+      device_id: deviceId,
+      temperature: 0,
+      humidity: 0,
+      pressure: 0,
+      gas_level: level / SCALE,
+    };
+    if (flags & FLAG_TIMESTAMPS) row.created_at = new Date(epoch * 1000).toISOString();
+    if (flags & FLAG_SUMMARY) {
+      row.gas_min = (level + reader.svarint()) / SCALE;
+      row.gas_max = (level + reader.svarint()) / SCALE;
+      row.gas_mean = (level + reader.svarint()) / SCALE;
+    }
+    if (metrics && i === 0) row.metrics = metrics;
+    rows.push(row);
+  }
+  if (!reader.done()) throw new BatchFormatError('Trailing bytes after batch');
+  return { deviceId, userId, rows };
+}
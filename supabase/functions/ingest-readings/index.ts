@@ -0,0 +1,57 @@
+import { createClient } from 'https://esm.sh/@supabase/supabase-js@2.39.3';
+import { decodeBatch } from '../_shared/reading_codec.ts';
+
+// Decodes the compact binary reading batches sent by the firmware and
+// bulk-inserts them into device_readings.
+const supabaseUrl = Deno.env.get('SUPABASE_URL') ?? '';
+const serviceRoleKey = Deno.env.get('SUPABASE_SERVICE_ROLE_KEY') ?? '';
+const supabase = createClient(supabaseUrl, serviceRoleKey, {
+  auth: {
+    persistSession: false,
+  },
+});
+
+const jsonHeaders = { 'Content-Type': 'application/json', 'Access-Control-Allow-Origin': '*' };
+
+Deno.serve(async (req) => {
+  if (req.method === 'OPTIONS') {
+    return new Response('ok', {
+      headers: {
+        'Access-Control-Allow-Origin': '*',
+        'Access-Control-Allow-Headers': 'authorization, x-client-info, apikey, content-type',
+      },
+    });
+  }
+
+  let batch;
+  try {
+    batch = decodeBatch(new Uint8Array(await req.arrayBuffer()));
+  } catch (error) {
+    return new Response(JSON.stringify({ error: error.message }), { headers: jsonHeaders, status: 400 });
+  }
+
+  // Only registered devices may write; unclaimed devices fall back to the
+  // owner stored on the device row
+  const { data: deviceData, error: deviceError } = await supabase
+    .from('devices')
+    .select('user_id')
+    .eq('id', batch.deviceId)
+    .single();
+
+  if (deviceError || !deviceData) {
+    return new Response(JSON.stringify({ error: 'Device not found' }), { headers: jsonHeaders, status: 404 });
+  }
+
+  const userId = batch.userId || deviceData.user_id;
+  if (userId) {
+    for (const row of batch.rows) row.user_id = userId;
+  }
+
+  const { error } = await supabase.from('device_readings').insert(batch.rows);
+  if (error) {
+    console.error('Error inserting readings:', error);
+    return new Response(JSON.stringify({ error: error.message }), { headers: jsonHeaders, status: 500 });
+  }
+
+  return new Response(JSON.stringify({ inserted: batch.rows.length }), { headers: jsonHeaders, status: 201 });
+});
@@ -0,0 +1,6 @@
+-- Per-interval statistics of the filtered MQ5 value, reported by the firmware
+-- alongside gas_level (the filtered value at the time the reading was taken).
+ALTER TABLE device_readings
+ADD COLUMN gas_min real,
+ADD COLUMN gas_max real,
+ADD COLUMN gas_mean real;
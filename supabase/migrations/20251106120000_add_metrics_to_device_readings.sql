@@ -0,0 +1,5 @@
+-- Runtime metrics summary of the device (heap, loop time, request latency,
+-- reconnects, ...), piggybacked on reading uploads. Only the first row of
+-- a batch carries it, at most every few minutes; the column is null otherwise.
+ALTER TABLE device_readings
+ADD COLUMN metrics jsonb;
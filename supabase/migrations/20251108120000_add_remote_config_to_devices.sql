@@ -0,0 +1,46 @@
+-- Remote configuration pulled by the firmware every few minutes. NULL keeps
+-- the firmware default. Thresholds are ratios to the device's own tracked
+-- clean-air baseline, so one value fits sensors with different baselines.
+ALTER TABLE devices
+ADD COLUMN IF NOT EXISTS location TEXT,
+ADD COLUMN IF NOT EXISTS updated_at TIMESTAMP WITH TIME ZONE DEFAULT now() NOT NULL,
+ADD COLUMN threshold_ratio REAL CHECK (threshold_ratio > 1),
+ADD COLUMN warning_ratio REAL CHECK (warning_ratio > 1 AND (threshold_ratio IS NULL OR warning_ratio < threshold_ratio)),
+ADD COLUMN alert_cooldown_s INTEGER CHECK (alert_cooldown_s BETWEEN 0 AND 86400),
+ADD COLUMN report_deadband REAL CHECK (report_deadband >= 0),
+ADD COLUMN report_heartbeat_s INTEGER CHECK (report_heartbeat_s BETWEEN 5 AND 86400);
+
+-- Devices only fetch rows changed since the updated_at they last applied
+create or replace function public.touch_updated_at()
+returns trigger as $$
+begin
+  new.updated_at := now();
+  return new;
+end;
+$$ language plpgsql;
+
+drop trigger if exists devices_touch_updated_at on devices;
+create trigger devices_touch_updated_at
+  before update on devices
+  for each row execute procedure public.touch_updated_at();
+
+-- The config columns of one device, or no row if it hasn't changed since
+-- `since`. An unchanged config then costs an empty array instead of the
+-- row. Security definer, so the device's anon key needs no SELECT on devices.
+create or replace function public.device_config(device uuid, since timestamp with time zone default null)
+returns table (
+  location text,
+  threshold_ratio real,
+  warning_ratio real,
+  alert_cooldown_s integer,
+  report_deadband real,
+  report_heartbeat_s integer,
+  updated_at timestamp with time zone
+) as $$
+  select d.location, d.threshold_ratio, d.warning_ratio, d.alert_cooldown_s,
+         d.report_deadband, d.report_heartbeat_s, d.updated_at
+  from public.devices d
+  where d.id = device and (since is null or d.updated_at > since);
+$$ language sql stable security definer set search_path = public;
+
+grant execute on function public.device_config(uuid, timestamp with time zone) to anon, authenticated;
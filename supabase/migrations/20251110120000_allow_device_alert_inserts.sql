@@ -0,0 +1,22 @@
+-- Devices post alerts with the anon key, so auth.uid() is NULL and the
+-- original insert policy rejected every one of them. Accept an alert only
+-- if its device belongs to the user it notifies; an unpaired device, or a
+-- forged user_id or device_id, gets a 4xx that the firmware doesn't retry.
+
+-- Security definer, so the anon key needs no SELECT on devices
+create or replace function public.device_belongs_to(device uuid, owner uuid)
+returns boolean as $$
+  select exists (
+    select 1 from public.devices d
+    where d.id = device and d.user_id = owner
+  );
+$$ language sql stable security definer set search_path = public;
+
+grant execute on function public.device_belongs_to(uuid, uuid) to anon, authenticated;
+
+DROP POLICY IF EXISTS "Devices can insert alerts with their user_id" ON alerts;
+
+CREATE POLICY "Devices can insert alerts for their owner"
+ON alerts FOR INSERT WITH CHECK (
+  auth.uid() = user_id OR public.device_belongs_to(device_id, user_id)
+);